@@ -1,6 +1,9 @@
 using UnityEngine;
+using UnityEngine.Rendering;
+using UnityEngine.Serialization;
 using System.Collections.Generic;
 using System;
+using Unity.Collections;
 
 /// <summary>
 /// Represents a building component with physical properties and materials.
@@ -22,27 +25,60 @@ public class BuildingComponent : MonoBehaviour
     public List<MaterialLayer> materialLayers = new List<MaterialLayer>();
     
     [Header("Runtime State")]
-    public float surfaceTemperature = 20.0f;
-    public float innerTemperature = 20.0f;
-    public float moistureContent = 0.0f;
+    [Tooltip("Initial value; while registered, the live value is held in the simulation manager's state store")]
+    [SerializeField, FormerlySerializedAs("surfaceTemperature")] private float surfaceTemperatureValue = 20.0f;
+    [SerializeField, FormerlySerializedAs("innerTemperature")] private float innerTemperatureValue = 20.0f;
+    [SerializeField, FormerlySerializedAs("moistureContent")] private float moistureContentValue = 0.0f;
     public Dictionary<string, string> properties = new Dictionary<string, string>();
     
     [Header("Visualization")]
     public Material defaultMaterial;
+    [Tooltip("Shared highlight material; if empty, highlighting tints the component's own material")]
     public Material highlightMaterial;
+    public Color highlightColor = new Color(1.0f, 0.8f, 0.2f);
     public bool isHighlighted = false;
     
     // Events
     public event Action<BuildingComponent> OnMaterialChanged;
     
-    // Cached renderer
+    // Dense slot in BuildingSimulationManager's state store (-1 while unregistered)
+    private ComponentStateStore stateStore;
+    private int stateIndex = -1;
+    
+    // Cached renderer and mesh filter. Renderers share the materials' assets; per-renderer tints go through a
+    // MaterialPropertyBlock, set only while needed so untinted renderers stay SRP Batcher compatible.
     private Renderer componentRenderer;
+    private MeshFilter meshFilter;
     private Material originalMaterial;
+    private bool hasPropertyBlock = false;
+    private static MaterialPropertyBlock propertyBlock;
+    private static readonly int BaseColorId = Shader.PropertyToID("_BaseColor"); // URP
+    private static readonly int ColorId = Shader.PropertyToID("_Color");         // Built-in
+    
+    // Shared heatmap material set by ThermalHeatmap while the heatmap is shown. The shader reads the state
+    // index from TEXCOORD3, which the component's own renderer gets from an additional vertex stream (index + 1
+    // per vertex, as in CombinedMeshChunk), so heatmap renderers need no property block and stay in the SRP Batcher.
+    private Material heatmapMaterial;
+    private Mesh heatmapIndexStream;
+    private int heatmapStreamIndex = -1;
+    private static readonly VertexAttributeDescriptor[] HeatmapStreamLayout =
+    {
+        new VertexAttributeDescriptor(VertexAttribute.TexCoord3, VertexAttributeFormat.Float32, 1)
+    };
+    
+    // Static combined mesh drawing this component in place of its own renderer (see BuildingMeshCombiner)
+    private CombinedMeshChunk combinedChunk;
     
     // Cached calculation results
     private float cachedUValue = 0;
     private bool needsRecalculation = true;
     
+    // Mesh surface for the scale it was looked up at (shared per mesh through MeshSurfaceCache)
+    private MeshSurfaceCache.MeshSurface cachedSurface;
+    private Mesh cachedSurfaceMesh;
+    private Vector3 cachedSurfaceScale;
+    private bool hasCachedSurface = false;
+    
     [Serializable]
     public class MaterialLayer
     {
@@ -61,12 +97,54 @@ public class BuildingComponent : MonoBehaviour
         }
     }
     
+    public ComponentStateStore StateStore => stateStore;
+    public int StateIndex => stateIndex;
+    public CombinedMeshChunk CombinedChunk => combinedChunk;
+    
+    public float surfaceTemperature
+    {
+        get => stateStore != null ? stateStore.SurfaceTemperature[stateIndex] : surfaceTemperatureValue;
+        set
+        {
+            if (stateStore != null)
+                stateStore.SetSurfaceTemperature(stateIndex, value);
+            else
+                surfaceTemperatureValue = value;
+        }
+    }
+    
+    public float innerTemperature
+    {
+        get => stateStore != null ? stateStore.InnerTemperature[stateIndex] : innerTemperatureValue;
+        set
+        {
+            if (stateStore != null)
+                stateStore.SetInnerTemperature(stateIndex, value);
+            else
+                innerTemperatureValue = value;
+        }
+    }
+    
+    public float moistureContent
+    {
+        get => stateStore != null ? stateStore.MoistureContent[stateIndex] : moistureContentValue;
+        set
+        {
+            if (stateStore != null)
+                stateStore.SetMoistureContent(stateIndex, value);
+            else
+                moistureContentValue = value;
+        }
+    }
+    
     void Awake()
     {
         componentRenderer = GetComponent<Renderer>();
+        meshFilter = GetComponent<MeshFilter>();
         if (componentRenderer != null)
         {
-            originalMaterial = componentRenderer.material;
+            // sharedMaterial: reading .material would clone a material per component
+            originalMaterial = componentRenderer.sharedMaterial;
         }
     }
     
@@ -129,35 +207,162 @@ public class BuildingComponent : MonoBehaviour
         if (componentRenderer == null)
             return;
             
-        if (isHighlighted)
+        ResolveAppearance(out Material material, out Color? tint);
+        
+        // Combined components are drawn by their chunk while they look like it; otherwise by their own renderer
+        if (combinedChunk != null && combinedChunk.TryDraw(this, material, tint))
         {
-            componentRenderer.material = highlightMaterial;
+            componentRenderer.enabled = false;
+            ApplyHeatmapIndex(-1);
             return;
         }
         
-        if (!isMultiLayer && currentMaterial != null && currentMaterial.renderMaterial != null)
+        componentRenderer.enabled = true;
+        componentRenderer.sharedMaterial = material;
+        ApplyTint(tint);
+        ApplyHeatmapIndex(heatmapMaterial != null && material == heatmapMaterial ? stateIndex : -1);
+    }
+    
+    /// <summary>
+    /// The material and optional color tint the component is currently drawn with
+    /// </summary>
+    internal void ResolveAppearance(out Material material, out Color? tint)
+    {
+        tint = null;
+        
+        if (isHighlighted && highlightMaterial != null)
         {
-            componentRenderer.material = currentMaterial.renderMaterial;
+            material = highlightMaterial;
+            return;
         }
-        else if (isMultiLayer && materialLayers.Count > 0)
+        
+        if (heatmapMaterial != null && !isHighlighted)
         {
-            // For multi-layer, visualize the outermost layer
-            var outerLayer = materialLayers[0];
-            foreach (var layer in materialLayers)
+            material = heatmapMaterial;
+            return;
+        }
+        
+        BuildingPhysicsMaterial visibleMaterial = GetVisibleMaterial();
+        material = visibleMaterial != null && visibleMaterial.renderMaterial != null ? visibleMaterial.renderMaterial : originalMaterial;
+        
+        // Physics materials without a render material show their color on the shared one
+        if (isHighlighted)
+        {
+            tint = highlightColor;
+        }
+        else if (visibleMaterial != null && visibleMaterial.renderMaterial == null && visibleMaterial.materialColor != Color.white)
+        {
+            tint = visibleMaterial.materialColor;
+        }
+    }
+    
+    /// <summary>
+    /// The physics material shown on the surface: the current material, or the outermost layer's
+    /// </summary>
+    private BuildingPhysicsMaterial GetVisibleMaterial()
+    {
+        if (!isMultiLayer)
+            return currentMaterial;
+        
+        if (materialLayers.Count == 0)
+            return null;
+        
+        var outerLayer = materialLayers[0];
+        foreach (var layer in materialLayers)
+        {
+            if (layer.layerOrder < outerLayer.layerOrder)
+                outerLayer = layer;
+        }
+        return outerLayer.material;
+    }
+    
+    /// <summary>
+    /// Sets or clears the per-renderer color override
+    /// </summary>
+    private void ApplyTint(Color? tint)
+    {
+        if (tint.HasValue)
+        {
+            if (propertyBlock == null)
+            {
+                propertyBlock = new MaterialPropertyBlock();
+            }
+            
+            propertyBlock.Clear();
+            propertyBlock.SetColor(BaseColorId, tint.Value);
+            propertyBlock.SetColor(ColorId, tint.Value);
+            componentRenderer.SetPropertyBlock(propertyBlock);
+            hasPropertyBlock = true;
+        }
+        else if (hasPropertyBlock)
+        {
+            componentRenderer.SetPropertyBlock(null);
+            hasPropertyBlock = false;
+        }
+    }
+    
+    /// <summary>
+    /// Gives the renderer a vertex stream holding the heatmap's state index, or removes it (-1)
+    /// </summary>
+    private void ApplyHeatmapIndex(int componentIndex)
+    {
+        MeshRenderer meshRenderer = componentRenderer as MeshRenderer;
+        Mesh mesh = meshFilter != null ? meshFilter.sharedMesh : null;
+        
+        if (componentIndex >= 0 && meshRenderer != null && mesh != null)
+        {
+            int vertexCount = mesh.vertexCount;
+            if (heatmapIndexStream == null)
             {
-                if (layer.layerOrder < outerLayer.layerOrder)
-                    outerLayer = layer;
+                heatmapIndexStream = new Mesh { name = name + " Heatmap Index", hideFlags = HideFlags.DontSave };
+                heatmapStreamIndex = -1;
             }
             
-            if (outerLayer.material != null && outerLayer.material.renderMaterial != null)
+            if (heatmapStreamIndex != componentIndex || heatmapIndexStream.vertexCount != vertexCount)
             {
-                componentRenderer.material = outerLayer.material.renderMaterial;
+                var ids = new NativeArray<float>(vertexCount, Allocator.Temp);
+                float id = componentIndex + 1;
+                for (int i = 0; i < vertexCount; i++)
+                {
+                    ids[i] = id;
+                }
+                
+                heatmapIndexStream.SetVertexBufferParams(vertexCount, HeatmapStreamLayout);
+                heatmapIndexStream.SetVertexBufferData(ids, 0, 0, vertexCount);
+                ids.Dispose();
+                heatmapStreamIndex = componentIndex;
             }
+            
+            meshRenderer.additionalVertexStreams = heatmapIndexStream;
         }
-        else
+        else if (heatmapIndexStream != null)
+        {
+            if (meshRenderer != null)
+            {
+                meshRenderer.additionalVertexStreams = null;
+            }
+            Destroy(heatmapIndexStream);
+            heatmapIndexStream = null;
+        }
+    }
+    
+    /// <summary>
+    /// Draws the component with the shared heatmap material, or restores its own materials when null.
+    /// Called by ThermalHeatmap when the heatmap is switched on or off, not when values change.
+    /// </summary>
+    public void SetHeatmapMaterial(Material material)
+    {
+        if (heatmapMaterial == material)
+            return;
+        
+        heatmapMaterial = material;
+        
+        // The chunk switches as a whole and reads each component's index from its vertex stream
+        if (combinedChunk != null)
         {
-            componentRenderer.material = originalMaterial;
+            combinedChunk.SetHeatmapMaterial(material);
         }
+        UpdateVisuals();
     }
     
     /// <summary>
@@ -229,37 +434,13 @@ public class BuildingComponent : MonoBehaviour
     }
     
     /// <summary>
-    /// Calculates the surface area of the component for heat transfer calculations
+    /// Calculates the world-space surface area of the component (all faces) for heat transfer calculations
     /// </summary>
     public float GetSurfaceArea()
     {
-        // Try to calculate from mesh
-        MeshFilter meshFilter = GetComponent<MeshFilter>();
-        if (meshFilter != null && meshFilter.sharedMesh != null)
+        if (TryGetMeshSurface(out MeshSurfaceCache.MeshSurface surface))
         {
-            // Get the mesh data
-            Vector3[] vertices = meshFilter.sharedMesh.vertices;
-            int[] triangles = meshFilter.sharedMesh.triangles;
-            
-            // Calculate total surface area
-            float area = 0f;
-            for (int i = 0; i < triangles.Length; i += 3)
-            {
-                // Get triangle vertices
-                Vector3 v1 = vertices[triangles[i]];
-                Vector3 v2 = vertices[triangles[i + 1]];
-                Vector3 v3 = vertices[triangles[i + 2]];
-                
-                // Calculate area of this triangle
-                Vector3 side1 = v2 - v1;
-                Vector3 side2 = v3 - v1;
-                Vector3 cross = Vector3.Cross(side1, side2);
-                area += cross.magnitude * 0.5f;
-            }
-            
-            // Convert from local to world scale
-            area *= transform.lossyScale.x * transform.lossyScale.z;
-            return area;
+            return surface.area;
         }
         
         // Fallback: approximate from bounds
@@ -277,6 +458,64 @@ public class BuildingComponent : MonoBehaviour
         return 1.0f; // Default value
     }
     
+    /// <summary>
+    /// World-space area of the component's dominant face, i.e. one side of a wall or slab
+    /// </summary>
+    public float GetFaceArea()
+    {
+        if (TryGetMeshSurface(out MeshSurfaceCache.MeshSurface surface))
+        {
+            return surface.faceArea;
+        }
+        
+        // Without a readable mesh, the bounds fallback already approximates a single face
+        return GetSurfaceArea();
+    }
+    
+    /// <summary>
+    /// World-space normal of the component's dominant face
+    /// </summary>
+    public Vector3 GetFaceNormal()
+    {
+        if (TryGetMeshSurface(out MeshSurfaceCache.MeshSurface surface))
+        {
+            return transform.rotation * surface.faceNormal;
+        }
+        return transform.forward;
+    }
+    
+    /// <summary>
+    /// Whether the component's dominant face is vertical, facing up or facing down
+    /// </summary>
+    public SurfaceOrientation GetSurfaceOrientation()
+    {
+        return MeshSurfaceCache.GetOrientation(GetFaceNormal());
+    }
+    
+    /// <summary>
+    /// Looks up the mesh surface, only going back to the shared cache when the mesh or the scale changed
+    /// </summary>
+    private bool TryGetMeshSurface(out MeshSurfaceCache.MeshSurface surface)
+    {
+        Mesh mesh = meshFilter != null ? meshFilter.sharedMesh : null;
+        if (mesh == null)
+        {
+            surface = default;
+            return false;
+        }
+        
+        Vector3 scale = transform.lossyScale;
+        if (!hasCachedSurface || mesh != cachedSurfaceMesh || scale != cachedSurfaceScale)
+        {
+            hasCachedSurface = MeshSurfaceCache.TryGet(mesh, scale, out cachedSurface);
+            cachedSurfaceMesh = mesh;
+            cachedSurfaceScale = scale;
+        }
+        
+        surface = cachedSurface;
+        return hasCachedSurface;
+    }
+    
     /// <summary>
     /// Gets a property value from the component
     /// </summary>
@@ -294,7 +533,50 @@ public class BuildingComponent : MonoBehaviour
     /// </summary>
     public void SetProperty(string propertyName, string value)
     {
-        properties[propertyName] = value;
+        properties[ComponentStateStore.InternPropertyKey(propertyName)] = value;
+    }
+    
+    /// <summary>
+    /// Called by ComponentStateStore when the component is assigned a dense slot
+    /// </summary>
+    internal void BindState(ComponentStateStore store, int index)
+    {
+        stateStore = store;
+        stateIndex = index;
+        
+        if (combinedChunk != null)
+        {
+            combinedChunk.RefreshComponentId(this);
+        }
+        
+        // A moved slot while the heatmap is shown: the index lives in the renderer's vertex stream
+        if (heatmapMaterial != null)
+        {
+            UpdateVisuals();
+        }
+    }
+    
+    /// <summary>
+    /// Called by ComponentStateStore when the component leaves the store; keeps its last state
+    /// </summary>
+    internal void UnbindState(float surface, float inner, float moisture)
+    {
+        stateStore = null;
+        stateIndex = -1;
+        if (combinedChunk != null)
+        {
+            combinedChunk.RefreshComponentId(this);
+        }
+        surfaceTemperatureValue = surface;
+        innerTemperatureValue = inner;
+        moistureContentValue = moisture;
+        
+        // The heatmap indexes the store; out of it, the component shows its own materials again
+        if (heatmapMaterial != null)
+        {
+            heatmapMaterial = null;
+            UpdateVisuals();
+        }
     }
     
     /// <summary>
@@ -322,55 +604,38 @@ public class BuildingComponent : MonoBehaviour
     }
     
     /// <summary>
-    /// Broadcasts material changes to the simulation system
+    /// Notifies the simulation manager, which batches changes and sends them at the end of the frame
     /// </summary>
     private void BroadcastMaterialChange()
     {
-        // Find the building simulation manager
-        BuildingSimulationManager simManager = FindObjectOfType<BuildingSimulationManager>();
+        BuildingSimulationManager simManager = BuildingSimulationManager.Instance;
         if (simManager == null)
             return;
             
-        // Create material data to send
-        Dictionary<string, object> materialData = new Dictionary<string, object>();
+        simManager.OnComponentMaterialChanged(this);
+    }
+    
+    /// <summary>
+    /// Called by CombinedMeshChunk when it takes over drawing the component, or lets go of it (null)
+    /// </summary>
+    internal void SetCombinedChunk(CombinedMeshChunk chunk)
+    {
+        combinedChunk = chunk;
+        UpdateVisuals();
+    }
+    
+    void OnDestroy()
+    {
+        stateStore?.Release(this);
         
-        if (!isMultiLayer && currentMaterial != null)
+        if (heatmapIndexStream != null)
         {
-            materialData["materialName"] = currentMaterial.materialName;
-            materialData["thermalConductivity"] = currentMaterial.thermalConductivity;
-            materialData["density"] = currentMaterial.density;
-            materialData["specificHeat"] = currentMaterial.specificHeatCapacity;
-            materialData["uValue"] = GetUValue();
-            materialData["thickness"] = componentThickness;
+            Destroy(heatmapIndexStream);
         }
-        else if (isMultiLayer)
+        
+        if (combinedChunk != null)
         {
-            List<Dictionary<string, object>> layers = new List<Dictionary<string, object>>();
-            
-            foreach (var layer in materialLayers)
-            {
-                if (layer.material != null)
-                {
-                    Dictionary<string, object> layerData = new Dictionary<string, object>
-                    {
-                        {"materialName", layer.material.materialName},
-                        {"thermalConductivity", layer.material.thermalConductivity},
-                        {"density", layer.material.density},
-                        {"specificHeat", layer.material.specificHeatCapacity},
-                        {"thickness", layer.thickness},
-                        {"layerOrder", layer.layerOrder}
-                    };
-                    
-                    layers.Add(layerData);
-                }
-            }
-            
-            materialData["layers"] = layers;
-            materialData["uValue"] = GetUValue();
-            materialData["totalThickness"] = GetTotalThickness();
+            combinedChunk.Remove(this);
         }
-        
-        // Send to simulation manager
-        simManager.OnComponentMaterialChanged(this, materialData);
     }
 }
\ No newline at end of file
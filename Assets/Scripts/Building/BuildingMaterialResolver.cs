@@ -0,0 +1,140 @@
+using System;
+using System.Collections.Generic;
+
+/// <summary>
+/// Resolves raw IFC material names to building physics materials.
+/// Built once from the loaded material library; lookups go through prebuilt name, alias and category
+/// tables, and every raw name is resolved at most once and memoized.
+/// </summary>
+public class BuildingMaterialResolver
+{
+    // Common abbreviations and variants found in IFC material names, mapped to a standardized
+    // material name (or category). Checked in order as case-insensitive substrings.
+    private static readonly KeyValuePair<string, string>[] aliases =
+    {
+        new KeyValuePair<string, string>("concrete", "concrete"),
+        new KeyValuePair<string, string>("conc", "concrete"),
+        new KeyValuePair<string, string>("brick", "brick"),
+        new KeyValuePair<string, string>("masonry", "brick"),
+        new KeyValuePair<string, string>("glass", "glass"),
+        new KeyValuePair<string, string>("glazing", "glass"),
+        new KeyValuePair<string, string>("window", "glass"),
+        new KeyValuePair<string, string>("steel", "steel"),
+        new KeyValuePair<string, string>("metal", "steel"),
+        new KeyValuePair<string, string>("aluminum", "aluminum"),
+        new KeyValuePair<string, string>("aluminium", "aluminum"),
+        new KeyValuePair<string, string>("timber", "wood"),
+        new KeyValuePair<string, string>("wood", "wood"),
+        new KeyValuePair<string, string>("insulation", "glasswool"),
+        new KeyValuePair<string, string>("insul", "glasswool"),
+        new KeyValuePair<string, string>("gypsum", "gypsum"),
+        new KeyValuePair<string, string>("plaster", "gypsum"),
+        new KeyValuePair<string, string>("drywall", "gypsum"),
+        new KeyValuePair<string, string>("tile", "ceramictile"),
+        new KeyValuePair<string, string>("ceramic", "ceramictile"),
+        new KeyValuePair<string, string>("stone", "stone"),
+        new KeyValuePair<string, string>("marble", "stone"),
+        new KeyValuePair<string, string>("granite", "stone"),
+        new KeyValuePair<string, string>("roof", "roof")
+    };
+    
+    private readonly List<BuildingPhysicsMaterial> materials = new List<BuildingPhysicsMaterial>();
+    private readonly Dictionary<string, BuildingPhysicsMaterial> materialsByName = new Dictionary<string, BuildingPhysicsMaterial>(StringComparer.OrdinalIgnoreCase);
+    private readonly Dictionary<string, BuildingPhysicsMaterial> materialsByCategory = new Dictionary<string, BuildingPhysicsMaterial>(StringComparer.OrdinalIgnoreCase);
+    
+    // Alias targets resolved against the library up front (null where the library has no match)
+    private readonly BuildingPhysicsMaterial[] aliasMaterials = new BuildingPhysicsMaterial[aliases.Length];
+    
+    // Memoized results per raw name, including misses
+    private readonly Dictionary<string, BuildingPhysicsMaterial> resolvedNames = new Dictionary<string, BuildingPhysicsMaterial>(StringComparer.Ordinal);
+    
+    public BuildingMaterialResolver(IEnumerable<BuildingPhysicsMaterial> library)
+    {
+        foreach (var material in library)
+        {
+            if (material == null)
+                continue;
+            
+            materials.Add(material);
+            
+            // Later materials with the same name replace earlier ones
+            if (!string.IsNullOrEmpty(material.materialName))
+            {
+                materialsByName[material.materialName] = material;
+            }
+            
+            // The first material of a category represents it
+            if (!string.IsNullOrEmpty(material.category) && !materialsByCategory.ContainsKey(material.category))
+            {
+                materialsByCategory.Add(material.category, material);
+            }
+        }
+        
+        for (int i = 0; i < aliases.Length; i++)
+        {
+            string target = aliases[i].Value;
+            if (!materialsByName.TryGetValue(target, out aliasMaterials[i]))
+            {
+                materialsByCategory.TryGetValue(target, out aliasMaterials[i]);
+            }
+        }
+    }
+    
+    /// <summary>
+    /// Number of distinct material names in the library
+    /// </summary>
+    public int Count => materialsByName.Count;
+    
+    /// <summary>
+    /// All loaded materials in library order
+    /// </summary>
+    public IReadOnlyList<BuildingPhysicsMaterial> Materials => materials;
+    
+    /// <summary>
+    /// Finds a physics material by name, falling back to common abbreviations and variants
+    /// </summary>
+    public BuildingPhysicsMaterial FindByName(string materialName)
+    {
+        if (string.IsNullOrEmpty(materialName))
+            return null;
+        
+        if (resolvedNames.TryGetValue(materialName, out BuildingPhysicsMaterial material))
+            return material;
+        
+        material = Resolve(materialName);
+        resolvedNames[materialName] = material;
+        return material;
+    }
+    
+    /// <summary>
+    /// Finds the representative material of a category (case-insensitive)
+    /// </summary>
+    public BuildingPhysicsMaterial FindByCategory(string category)
+    {
+        if (string.IsNullOrEmpty(category))
+            return null;
+        
+        materialsByCategory.TryGetValue(category, out BuildingPhysicsMaterial material);
+        return material;
+    }
+    
+    private BuildingPhysicsMaterial Resolve(string materialName)
+    {
+        // Try exact match
+        if (materialsByName.TryGetValue(materialName, out BuildingPhysicsMaterial material))
+        {
+            return material;
+        }
+        
+        // Try common abbreviations and variants
+        for (int i = 0; i < aliases.Length; i++)
+        {
+            if (aliasMaterials[i] != null && materialName.IndexOf(aliases[i].Key, StringComparison.OrdinalIgnoreCase) >= 0)
+            {
+                return aliasMaterials[i];
+            }
+        }
+        
+        return null;
+    }
+}
\ No newline at end of file
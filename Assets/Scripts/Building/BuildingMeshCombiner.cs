@@ -0,0 +1,360 @@
+using UnityEngine;
+using UnityEngine.Rendering;
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using Unity.Burst;
+using Unity.Collections;
+using Unity.Jobs;
+using Unity.Mathematics;
+
+/// <summary>
+/// Merges static building elements into CombinedMeshChunks, one set per storey and appearance
+/// (render material and tint, i.e. per physics material shown). Chunks use 16-bit indices and stay
+/// below maxVertices, so a building of thousands of elements draws in a few calls per storey.
+/// Components keep their GameObject, collider and BuildingComponent; only their renderer is disabled
+/// while a chunk draws them. Meshes are merged in a Burst job from Mesh.AcquireReadOnlyMeshData.
+/// Chunks carry position, normal, tangent, color, uv0 and uv1 (lightmap UVs); attributes a source mesh
+/// lacks get Unity's defaults (tangent along +X, white, uv1 falls back to uv0 as in lightmap baking).
+/// Main thread only.
+/// </summary>
+public static class BuildingMeshCombiner
+{
+    public const int MaxChunkVertices = 65535; // 16-bit indices
+    
+    /// <summary>
+    /// Components that will be merged into one chunk
+    /// </summary>
+    public class ChunkPlan
+    {
+        public string storeyId;
+        public Material material;
+        public Color? tint;
+        public readonly List<BuildingComponent> components = new List<BuildingComponent>();
+        public readonly List<Mesh> meshes = new List<Mesh>();
+        public int vertexCount;
+        public int indexCount;
+    }
+    
+    private readonly struct GroupKey : IEquatable<GroupKey>
+    {
+        private readonly string storeyId;
+        private readonly Material material;
+        private readonly Color tint;
+        private readonly bool tinted;
+        
+        public GroupKey(string storeyId, Material material, Color? tint)
+        {
+            this.storeyId = storeyId ?? string.Empty;
+            this.material = material;
+            this.tint = tint ?? default;
+            tinted = tint.HasValue;
+        }
+        
+        public bool Equals(GroupKey other) =>
+            storeyId == other.storeyId && ReferenceEquals(material, other.material) &&
+            tinted == other.tinted && tint == other.tint;
+        public override bool Equals(object obj) => obj is GroupKey other && Equals(other);
+        public override int GetHashCode() => (storeyId.GetHashCode() * 397) ^ (material != null ? material.GetInstanceID() : 0);
+    }
+    
+    [StructLayout(LayoutKind.Sequential)]
+    private struct CombinedVertex
+    {
+        public float3 position;
+        public float3 normal;
+        public float4 tangent;
+        public Color32 color;
+        public float2 uv;
+        public float2 uv1;
+    }
+    
+    private static readonly VertexAttributeDescriptor[] vertexLayout =
+    {
+        new VertexAttributeDescriptor(VertexAttribute.Position, VertexAttributeFormat.Float32, 3, 0),
+        new VertexAttributeDescriptor(VertexAttribute.Normal, VertexAttributeFormat.Float32, 3, 0),
+        new VertexAttributeDescriptor(VertexAttribute.Tangent, VertexAttributeFormat.Float32, 4, 0),
+        new VertexAttributeDescriptor(VertexAttribute.Color, VertexAttributeFormat.UNorm8, 4, 0),
+        new VertexAttributeDescriptor(VertexAttribute.TexCoord0, VertexAttributeFormat.Float32, 2, 0),
+        new VertexAttributeDescriptor(VertexAttribute.TexCoord1, VertexAttributeFormat.Float32, 2, 0),
+        new VertexAttributeDescriptor(VertexAttribute.TexCoord3, VertexAttributeFormat.Float32, 1, 1) // Component ID stream
+    };
+    
+    /// <summary>
+    /// Groups the combinable components by storey and appearance and splits the groups into chunks.
+    /// Movable elements (doors, furnishings), multi-material or lightmapped renderers and unreadable meshes are left alone.
+    /// </summary>
+    public static List<ChunkPlan> Plan(IEnumerable<BuildingComponent> components, int maxVertices = MaxChunkVertices)
+    {
+        maxVertices = Mathf.Clamp(maxVertices, 3, MaxChunkVertices);
+        Dictionary<GroupKey, ChunkPlan> openChunks = new Dictionary<GroupKey, ChunkPlan>();
+        List<ChunkPlan> plans = new List<ChunkPlan>();
+        
+        foreach (var component in components)
+        {
+            if (!TryGetCombinableMesh(component, out Mesh mesh))
+                continue;
+            
+            int vertexCount = mesh.vertexCount;
+            if (vertexCount > maxVertices)
+                continue;
+            
+            component.ResolveAppearance(out Material material, out Color? tint);
+            if (material == null)
+                continue;
+            
+            GroupKey key = new GroupKey(component.storeyId, material, tint);
+            if (!openChunks.TryGetValue(key, out ChunkPlan plan) || plan.vertexCount + vertexCount > maxVertices)
+            {
+                plan = new ChunkPlan { storeyId = component.storeyId, material = material, tint = tint };
+                openChunks[key] = plan;
+                plans.Add(plan);
+            }
+            
+            plan.components.Add(component);
+            plan.meshes.Add(mesh);
+            plan.vertexCount += vertexCount;
+            plan.indexCount += (int)mesh.GetIndexCount(0);
+        }
+        
+        // A chunk of one saves nothing
+        plans.RemoveAll(plan => plan.components.Count < 2);
+        return plans;
+    }
+    
+    /// <summary>
+    /// Builds a planned chunk under parent (usually the storey's transform) and hands its components over to it
+    /// </summary>
+    public static CombinedMeshChunk Build(ChunkPlan plan, Transform parent)
+    {
+        // Components destroyed since planning
+        for (int i = plan.components.Count - 1; i >= 0; i--)
+        {
+            if (plan.components[i] == null || plan.meshes[i] == null)
+            {
+                plan.components.RemoveAt(i);
+                plan.meshes.RemoveAt(i);
+            }
+        }
+        if (plan.components.Count == 0)
+            return null;
+        
+        GameObject chunkObject = new GameObject($"Combined {plan.material.name}");
+        chunkObject.transform.SetParent(parent, false);
+        
+        int count = plan.components.Count;
+        Matrix4x4 worldToChunk = chunkObject.transform.worldToLocalMatrix;
+        
+        NativeArray<float4x4> transforms = new NativeArray<float4x4>(count, Allocator.TempJob);
+        NativeArray<float> ids = new NativeArray<float>(count, Allocator.TempJob);
+        NativeArray<int> vertexStarts = new NativeArray<int>(count, Allocator.TempJob);
+        NativeArray<int> indexStarts = new NativeArray<int>(count, Allocator.TempJob);
+        List<Vector2Int> vertexRanges = new List<Vector2Int>(count);
+        List<Vector2Int> indexRanges = new List<Vector2Int>(count);
+        
+        int vertexCount = 0;
+        int indexCount = 0;
+        for (int i = 0; i < count; i++)
+        {
+            Mesh source = plan.meshes[i];
+            int sourceVertices = source.vertexCount;
+            int sourceIndices = (int)source.GetIndexCount(0);
+            
+            transforms[i] = worldToChunk * plan.components[i].transform.localToWorldMatrix;
+            ids[i] = plan.components[i].StateIndex + 1;
+            vertexStarts[i] = vertexCount;
+            indexStarts[i] = indexCount;
+            vertexRanges.Add(new Vector2Int(vertexCount, sourceVertices));
+            indexRanges.Add(new Vector2Int(indexCount, sourceIndices));
+            
+            vertexCount += sourceVertices;
+            indexCount += sourceIndices;
+        }
+        
+        NativeArray<ushort> indices = new NativeArray<ushort>(indexCount, Allocator.Persistent);
+        NativeArray<float> componentIds = new NativeArray<float>(vertexCount, Allocator.Persistent);
+        NativeArray<float3> bounds = new NativeArray<float3>(2, Allocator.TempJob);
+        
+        Mesh.MeshDataArray output = Mesh.AllocateWritableMeshData(1);
+        Mesh.MeshData outputData = output[0];
+        outputData.SetVertexBufferParams(vertexCount, vertexLayout);
+        outputData.SetIndexBufferParams(indexCount, IndexFormat.UInt16);
+        
+        using (Mesh.MeshDataArray sources = Mesh.AcquireReadOnlyMeshData(plan.meshes))
+        {
+            var job = new CombineJob
+            {
+                sources = sources,
+                transforms = transforms,
+                ids = ids,
+                vertexStarts = vertexStarts,
+                indexStarts = indexStarts,
+                vertices = outputData.GetVertexData<CombinedVertex>(0),
+                componentIds = componentIds,
+                indices = indices,
+                bounds = bounds
+            };
+            job.Schedule().Complete();
+        }
+        
+        outputData.GetVertexData<float>(1).CopyFrom(componentIds);
+        outputData.GetIndexData<ushort>().CopyFrom(indices);
+        
+        Bounds meshBounds = new Bounds();
+        meshBounds.SetMinMax(bounds[0], bounds[1]);
+        outputData.subMeshCount = 1;
+        outputData.SetSubMesh(0, new SubMeshDescriptor(0, indexCount)
+        {
+            bounds = meshBounds,
+            vertexCount = vertexCount
+        }, MeshUpdateFlags.DontRecalculateBounds);
+        
+        Mesh mesh = new Mesh { name = chunkObject.name };
+        Mesh.ApplyAndDisposeWritableMeshData(output, mesh, MeshUpdateFlags.DontRecalculateBounds);
+        mesh.bounds = meshBounds;
+        
+        transforms.Dispose();
+        ids.Dispose();
+        vertexStarts.Dispose();
+        indexStarts.Dispose();
+        bounds.Dispose();
+        
+        CombinedMeshChunk chunk = chunkObject.AddComponent<CombinedMeshChunk>();
+        chunk.storeyId = plan.storeyId;
+        chunk.Initialize(mesh, plan.material, plan.tint, indices, componentIds, plan.components, vertexRanges, indexRanges);
+        return chunk;
+    }
+    
+    private static bool TryGetCombinableMesh(BuildingComponent component, out Mesh mesh)
+    {
+        mesh = null;
+        if (component == null || component.CombinedChunk != null)
+            return false;
+        
+        IfcElementKind kind = IfcElementClassifier.Classify(component.ifcType);
+        if (kind == IfcElementKind.Door || kind == IfcElementKind.Furnishing)
+            return false;
+        
+        MeshRenderer meshRenderer = component.GetComponent<MeshRenderer>();
+        MeshFilter meshFilter = component.GetComponent<MeshFilter>();
+        if (meshRenderer == null || meshFilter == null || meshRenderer.sharedMaterials.Length != 1)
+            return false;
+        
+        // Baked lightmap UVs are only valid with the renderer's own lightmap scale and offset
+        if (meshRenderer.lightmapIndex >= 0 && meshRenderer.lightmapIndex < 0xFFFE)
+            return false;
+        
+        mesh = meshFilter.sharedMesh;
+        return mesh != null && mesh.isReadable && mesh.subMeshCount == 1 && mesh.GetTopology(0) == MeshTopology.Triangles;
+    }
+    
+    /// <summary>
+    /// Transforms every source mesh into chunk space and appends it. Normals use the inverse transpose,
+    /// and mirrored transforms get their winding and tangent sign flipped so faces keep pointing outward.
+    /// </summary>
+    [BurstCompile]
+    private struct CombineJob : IJob
+    {
+        [ReadOnly] public Mesh.MeshDataArray sources;
+        [ReadOnly] public NativeArray<float4x4> transforms;
+        [ReadOnly] public NativeArray<float> ids;
+        [ReadOnly] public NativeArray<int> vertexStarts;
+        [ReadOnly] public NativeArray<int> indexStarts;
+        public NativeArray<CombinedVertex> vertices;
+        public NativeArray<float> componentIds;
+        public NativeArray<ushort> indices;
+        public NativeArray<float3> bounds; // min, max
+        
+        public void Execute()
+        {
+            float3 min = new float3(float.MaxValue);
+            float3 max = new float3(float.MinValue);
+            
+            for (int s = 0; s < sources.Length; s++)
+            {
+                Mesh.MeshData data = sources[s];
+                int vertexCount = data.vertexCount;
+                int baseVertex = vertexStarts[s];
+                float4x4 matrix = transforms[s];
+                float3x3 linear = new float3x3(matrix.c0.xyz, matrix.c1.xyz, matrix.c2.xyz);
+                float3x3 normalMatrix = math.transpose(math.inverse(linear));
+                
+                NativeArray<Vector3> positions = new NativeArray<Vector3>(vertexCount, Allocator.Temp);
+                NativeArray<Vector3> normals = new NativeArray<Vector3>(vertexCount, Allocator.Temp);
+                NativeArray<Vector4> tangents = new NativeArray<Vector4>(vertexCount, Allocator.Temp);
+                NativeArray<Color32> colors = new NativeArray<Color32>(vertexCount, Allocator.Temp);
+                NativeArray<Vector2> uvs = new NativeArray<Vector2>(vertexCount, Allocator.Temp);
+                NativeArray<Vector2> uvs1 = new NativeArray<Vector2>(vertexCount, Allocator.Temp);
+                data.GetVertices(positions);
+                if (data.HasVertexAttribute(VertexAttribute.Normal))
+                {
+                    data.GetNormals(normals);
+                }
+                bool hasTangents = data.HasVertexAttribute(VertexAttribute.Tangent);
+                if (hasTangents)
+                {
+                    data.GetTangents(tangents);
+                }
+                bool hasColors = data.HasVertexAttribute(VertexAttribute.Color);
+                if (hasColors)
+                {
+                    data.GetColors(colors);
+                }
+                if (data.HasVertexAttribute(VertexAttribute.TexCoord0))
+                {
+                    data.GetUVs(0, uvs);
+                }
+                bool hasUv1 = data.HasVertexAttribute(VertexAttribute.TexCoord1);
+                if (hasUv1)
+                {
+                    data.GetUVs(1, uvs1);
+                }
+                
+                bool mirrored = math.determinant(linear) < 0f;
+                float tangentSign = mirrored ? -1f : 1f;
+                
+                for (int v = 0; v < vertexCount; v++)
+                {
+                    float3 position = math.transform(matrix, positions[v]);
+                    min = math.min(min, position);
+                    max = math.max(max, position);
+                    
+                    float4 tangent = hasTangents ? (float4)tangents[v] : new float4(1f, 0f, 0f, 1f);
+                    vertices[baseVertex + v] = new CombinedVertex
+                    {
+                        position = position,
+                        normal = math.normalizesafe(math.mul(normalMatrix, normals[v])),
+                        tangent = new float4(math.normalizesafe(math.mul(linear, tangent.xyz)), tangent.w * tangentSign),
+                        color = hasColors ? colors[v] : new Color32(255, 255, 255, 255),
+                        uv = uvs[v],
+                        uv1 = hasUv1 ? uvs1[v] : uvs[v]
+                    };
+                    componentIds[baseVertex + v] = ids[s];
+                }
+                
+                var subMesh = data.GetSubMesh(0);
+                NativeArray<int> sourceIndices = new NativeArray<int>(subMesh.indexCount, Allocator.Temp);
+                data.GetIndices(sourceIndices, 0);
+                
+                int indexStart = indexStarts[s];
+                for (int i = 0; i + 2 < sourceIndices.Length; i += 3)
+                {
+                    indices[indexStart + i] = (ushort)(baseVertex + sourceIndices[i]);
+                    indices[indexStart + i + 1] = (ushort)(baseVertex + sourceIndices[mirrored ? i + 2 : i + 1]);
+                    indices[indexStart + i + 2] = (ushort)(baseVertex + sourceIndices[mirrored ? i + 1 : i + 2]);
+                }
+                
+                sourceIndices.Dispose();
+                uvs1.Dispose();
+                uvs.Dispose();
+                colors.Dispose();
+                tangents.Dispose();
+                normals.Dispose();
+                positions.Dispose();
+            }
+            
+            bounds[0] = min;
+            bounds[1] = max;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using Newtonsoft.Json;
+
+/// <summary>
+/// Streams the building metadata JSON extracted from IFC with a JsonTextReader.
+/// Storeys, spaces, components and materials are raised one entry at a time as they are read,
+/// and component geometry blobs are skipped, so memory use does not grow with file size.
+/// Does not touch the Unity API and may run on a worker thread.
+/// </summary>
+public class BuildingMetadataReader
+{
+    // Events raised for each entry, in file order
+    public event Action<BuildingOrganizer.ProjectInfo> OnProjectInfoRead;
+    public event Action<string, BuildingOrganizer.StoreyData> OnStoreyRead;
+    public event Action<string, BuildingOrganizer.SpaceData> OnSpaceRead;
+    public event Action<string, BuildingOrganizer.ComponentData> OnComponentRead;
+    public event Action<string, BuildingOrganizer.MaterialInfo> OnMaterialRead;
+    
+    /// <summary>
+    /// Raised once, as soon as both the storey and space sections have been read, or at the end of the
+    /// document if either is missing (a missing section counts as empty)
+    /// </summary>
+    public event Action OnSpatialStructureRead;
+    
+    /// <summary>
+    /// True once both the storey and space sections have been read completely, or the document has ended.
+    /// Components read before this point arrive before the spatial structure is known.
+    /// </summary>
+    public bool SpatialStructureRead => storeysRead && spacesRead;
+    
+    public int StoreyCount { get; private set; }
+    public int SpaceCount { get; private set; }
+    public int ComponentCount { get; private set; }
+    
+    private readonly JsonSerializer serializer = JsonSerializer.CreateDefault();
+    private bool storeysRead;
+    private bool spacesRead;
+    private bool spatialStructureRaised;
+    
+    /// <summary>
+    /// Opens a metadata file on disk for sequential streaming without loading it into memory
+    /// </summary>
+    public static Stream OpenFile(string path)
+    {
+        return new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read, 64 * 1024, FileOptions.SequentialScan);
+    }
+    
+    /// <summary>
+    /// Wraps raw UTF-8 metadata bytes (e.g. TextAsset.bytes) in a read-only stream
+    /// </summary>
+    public static Stream OpenBytes(byte[] bytes)
+    {
+        return new MemoryStream(bytes, false);
+    }
+    
+    /// <summary>
+    /// Reads the whole document, raising an event for every entry
+    /// </summary>
+    public void Read(TextReader text)
+    {
+        using (JsonTextReader reader = new JsonTextReader(text))
+        {
+            reader.CloseInput = false;
+            reader.DateParseHandling = DateParseHandling.None; // Keep date-like property values as strings
+            
+            if (!reader.Read() || reader.TokenType != JsonToken.StartObject)
+                throw new JsonSerializationException("Building metadata must be a JSON object");
+            
+            while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+            {
+                string section = (string)reader.Value;
+                reader.Read();
+                
+                switch (section)
+                {
+                    case "project_info":
+                        BuildingOrganizer.ProjectInfo projectInfo = serializer.Deserialize<BuildingOrganizer.ProjectInfo>(reader);
+                        OnProjectInfoRead?.Invoke(projectInfo);
+                        break;
+                    
+                    case "building_storeys":
+                        ReadEntries(reader, (id, r) =>
+                        {
+                            StoreyCount++;
+                            OnStoreyRead?.Invoke(id, serializer.Deserialize<BuildingOrganizer.StoreyData>(r));
+                        });
+                        storeysRead = true;
+                        RaiseSpatialStructureRead();
+                        break;
+                    
+                    case "spaces":
+                        ReadEntries(reader, (id, r) =>
+                        {
+                            SpaceCount++;
+                            OnSpaceRead?.Invoke(id, serializer.Deserialize<BuildingOrganizer.SpaceData>(r));
+                        });
+                        spacesRead = true;
+                        RaiseSpatialStructureRead();
+                        break;
+                    
+                    case "components":
+                        ReadEntries(reader, (id, r) =>
+                        {
+                            ComponentCount++;
+                            BuildingOrganizer.ComponentData component = ReadComponent(r);
+                            OnComponentRead?.Invoke(id, component);
+                        });
+                        break;
+                    
+                    case "materials":
+                        ReadEntries(reader, (id, r) =>
+                        {
+                            OnMaterialRead?.Invoke(id, serializer.Deserialize<BuildingOrganizer.MaterialInfo>(r));
+                        });
+                        break;
+                    
+                    default:
+                        reader.Skip();
+                        break;
+                }
+            }
+        }
+        
+        storeysRead = true;
+        spacesRead = true;
+        RaiseSpatialStructureRead();
+    }
+    
+    private void RaiseSpatialStructureRead()
+    {
+        if (spatialStructureRaised || !SpatialStructureRead)
+            return;
+        
+        spatialStructureRaised = true;
+        OnSpatialStructureRead?.Invoke();
+    }
+    
+    /// <summary>
+    /// Iterates the entries of a GlobalId-keyed object, leaving the reader on each entry's value
+    /// </summary>
+    private static void ReadEntries(JsonTextReader reader, Action<string, JsonTextReader> readEntry)
+    {
+        if (reader.TokenType == JsonToken.Null)
+            return;
+        
+        if (reader.TokenType != JsonToken.StartObject)
+        {
+            reader.Skip();
+            return;
+        }
+        
+        while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+        {
+            string id = (string)reader.Value;
+            reader.Read();
+            
+            if (reader.TokenType == JsonToken.Null)
+                continue;
+            
+            readEntry(id, reader);
+        }
+    }
+    
+    /// <summary>
+    /// Reads a single component by hand; the geometry section is skipped without being materialized
+    /// </summary>
+    private static BuildingOrganizer.ComponentData ReadComponent(JsonTextReader reader)
+    {
+        BuildingOrganizer.ComponentData component = new BuildingOrganizer.ComponentData();
+        
+        if (reader.TokenType != JsonToken.StartObject)
+        {
+            reader.Skip();
+            return component;
+        }
+        
+        while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+        {
+            string field = (string)reader.Value;
+            reader.Read();
+            
+            switch (field)
+            {
+                case "name": component.name = ReadString(reader); break;
+                case "type": component.type = ReadString(reader); break;
+                case "global_id": component.global_id = ReadString(reader); break;
+                case "storey_id": component.storey_id = ReadString(reader); break;
+                case "space_id": component.space_id = ReadString(reader); break;
+                case "properties": ReadStringDictionary(reader, component.properties); break;
+                case "materials": ReadMaterialList(reader, component.materials); break;
+                default: reader.Skip(); break; // geometry and unknown fields
+            }
+        }
+        
+        return component;
+    }
+    
+    private static void ReadMaterialList(JsonTextReader reader, List<BuildingOrganizer.MaterialData> materials)
+    {
+        if (reader.TokenType != JsonToken.StartArray)
+        {
+            reader.Skip();
+            return;
+        }
+        
+        while (reader.Read() && reader.TokenType != JsonToken.EndArray)
+        {
+            if (reader.TokenType != JsonToken.StartObject)
+            {
+                reader.Skip();
+                continue;
+            }
+            
+            BuildingOrganizer.MaterialData material = new BuildingOrganizer.MaterialData();
+            while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+            {
+                string field = (string)reader.Value;
+                reader.Read();
+                
+                switch (field)
+                {
+                    case "name": material.name = ReadString(reader); break;
+                    case "type": material.type = ReadString(reader); break;
+                    case "thickness": material.thickness = (float)(ReadDouble(reader) ?? 0.0); break;
+                    case "layer_index":
+                        double? layerIndex = ReadDouble(reader);
+                        material.layer_index = layerIndex.HasValue ? (int?)(int)layerIndex.Value : null;
+                        break;
+                    default: reader.Skip(); break;
+                }
+            }
+            materials.Add(material);
+        }
+    }
+    
+    private static void ReadStringDictionary(JsonTextReader reader, Dictionary<string, string> target)
+    {
+        if (reader.TokenType != JsonToken.StartObject)
+        {
+            reader.Skip();
+            return;
+        }
+        
+        while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+        {
+            string key = (string)reader.Value;
+            reader.Read();
+            
+            if (reader.TokenType == JsonToken.StartObject || reader.TokenType == JsonToken.StartArray)
+            {
+                reader.Skip(); // Nested values cannot be stored as strings
+                continue;
+            }
+            
+            target[key] = ReadString(reader);
+        }
+    }
+    
+    /// <summary>
+    /// Converts the current primitive token to a string, matching Json.NET's string conversion
+    /// </summary>
+    private static string ReadString(JsonTextReader reader)
+    {
+        switch (reader.TokenType)
+        {
+            case JsonToken.String:
+                return (string)reader.Value;
+            case JsonToken.Null:
+            case JsonToken.Undefined:
+                return null;
+            case JsonToken.Boolean:
+                return (bool)reader.Value ? "True" : "False";
+            case JsonToken.StartObject:
+            case JsonToken.StartArray:
+                reader.Skip();
+                return null;
+            default:
+                return Convert.ToString(reader.Value, CultureInfo.InvariantCulture);
+        }
+    }
+    
+    private static double? ReadDouble(JsonTextReader reader)
+    {
+        switch (reader.TokenType)
+        {
+            case JsonToken.Integer:
+            case JsonToken.Float:
+                return Convert.ToDouble(reader.Value, CultureInfo.InvariantCulture);
+            case JsonToken.String:
+                if (double.TryParse((string)reader.Value, NumberStyles.Float, CultureInfo.InvariantCulture, out double parsed))
+                    return parsed;
+                return null;
+            case JsonToken.StartObject:
+            case JsonToken.StartArray:
+                reader.Skip();
+                return null;
+            default:
+                return null;
+        }
+    }
+}
\ No newline at end of file
@@ -1,7 +1,13 @@
 using UnityEngine;
+using System;
+using System.Collections;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
-using Newtonsoft.Json;
+using System.Diagnostics;
 using System.IO;
+using System.Threading;
+using System.Threading.Tasks;
+using Debug = UnityEngine.Debug;
 
 /// <summary>
 /// Responsible for organizing and setting up building elements from IFC data in Unity.
@@ -11,6 +17,8 @@ public class BuildingOrganizer : MonoBehaviour
 {
     [Header("IFC Data")]
     public TextAsset buildingMetadata;
+    [Tooltip("Optional metadata JSON on disk (absolute or relative to StreamingAssets). Streamed instead of loading buildingMetadata, recommended for large exports.")]
+    public string metadataFilePath;
     public Transform buildingRoot;
     
     [Header("Material Assignment")]
@@ -20,22 +28,154 @@ public class BuildingOrganizer : MonoBehaviour
     [Header("Organization")]
     public bool createHierarchy = true;
     public bool addMissingColliders = true;
+    [Tooltip("Cook mesh colliders in a background job and attach them over frames, around the player's storey first")]
+    public bool deferMeshColliders = true;
+    
+    [Header("Selection")]
+    [Tooltip("Build a BVH over component bounds after import, for picking and region queries without colliders")]
+    public bool buildSpatialIndex = true;
+    [Tooltip("Cook MeshColliders for every wall. Otherwise walls that are plain boxes get a BoxCollider and only walls with openings or other shapes are cooked.")]
+    public bool addWallMeshColliders = false;
+    
+    [Header("Static Combining")]
+    [Tooltip("After import, merge static elements per storey and material into combined meshes (components stay pickable)")]
+    public bool combineStaticMeshes = false;
+    [Tooltip("Vertex limit of one combined mesh; combined meshes use 16-bit indices")]
+    [Range(1024, BuildingMeshCombiner.MaxChunkVertices)]
+    public int maxVerticesPerChunk = BuildingMeshCombiner.MaxChunkVertices;
+    
+    [Header("Import")]
+    [Tooltip("Parse on a worker thread and spread scene setup across frames instead of importing in Start")]
+    public bool timeSlicedImport = true;
+    [Tooltip("Main-thread milliseconds per frame spent on scene setup during a time-sliced import")]
+    [Range(0.5f, 50f)]
+    public float frameBudgetMilliseconds = 4.0f;
+    [Tooltip("Parsed components the worker may queue ahead of the main thread")]
+    public int importQueueCapacity = 2048;
+    
+    // Import progress
+    public bool IsImporting { get; private set; }
+    public bool IsImportComplete { get; private set; }
+    
+    // Events
+    public event Action<float, string> OnImportProgress; // progress 0-1, current stage
+    public event Action OnImportCompleted;
+    
+    /// <summary>
+    /// Spaces read from the building metadata, keyed by GlobalId. Empty until SpatialStructureReady.
+    /// </summary>
+    public IReadOnlyDictionary<string, SpaceData> Spaces => data != null && spatialStructureReady ? data.spaces : noSpaces;
+    
+    /// <summary>
+    /// Storeys read from the building metadata, keyed by GlobalId. Empty until SpatialStructureReady.
+    /// </summary>
+    public IReadOnlyDictionary<string, StoreyData> Storeys => data != null && spatialStructureReady ? data.building_storeys : noStoreys;
+    
+    /// <summary>
+    /// True once storeys and spaces have been read (and the hierarchy created, if requested)
+    /// </summary>
+    public bool SpatialStructureReady => spatialStructureReady;
+    
+    /// <summary>
+    /// Combined meshes created by CombineStaticMeshes
+    /// </summary>
+    public IReadOnlyList<CombinedMeshChunk> CombinedChunks => combinedChunks;
+    
+    /// <summary>
+    /// Spatial index over the imported components (null until the import completes, or if disabled)
+    /// </summary>
+    public ComponentSpatialIndex SpatialIndex => spatialIndex;
     
     // Runtime references
     private BuildingData data;
-    private Dictionary<string, BuildingPhysicsMaterial> availableMaterials = new Dictionary<string, BuildingPhysicsMaterial>();
+    private BuildingMaterialResolver materialResolver;
+    private static readonly Dictionary<string, SpaceData> noSpaces = new Dictionary<string, SpaceData>();
+    private static readonly Dictionary<string, StoreyData> noStoreys = new Dictionary<string, StoreyData>();
+    private MeshColliderBaker colliderBaker;
+    
+    // Spatial structure index, keyed by IFC GlobalId (built in CreateBuildingHierarchy)
+    private Dictionary<string, Transform> storeyTransforms = new Dictionary<string, Transform>();
+    private Dictionary<string, Transform> spaceTransforms = new Dictionary<string, Transform>();
+    private bool spatialStructureReady;
+    
+    // Components applied before the spatial structure was read; parented once the hierarchy exists
+    private readonly List<BuildingComponent> unparentedComponents = new List<BuildingComponent>();
+    private int unparentedIndex;
+    
+    private readonly List<CombinedMeshChunk> combinedChunks = new List<CombinedMeshChunk>();
+    
+    // Chunks planned for the static elements not combined yet, built from combinePlanIndex on
+    private List<BuildingMeshCombiner.ChunkPlan> combinePlans;
+    private int combinePlanIndex;
+    private int combinedComponentCount;
+    private readonly List<Vector3> colliderVertices = new List<Vector3>();
+    private ComponentSpatialIndex spatialIndex;
+    
+    // Worker-thread parsing state for time-sliced imports
+    private CancellationTokenSource importCancellation;
+    private Coroutine importRoutine;
     
     void Start()
     {
-        if (buildingMetadata != null)
+        if (buildingMetadata != null || !string.IsNullOrEmpty(metadataFilePath))
         {
+            // Surfaces of a previously imported building would otherwise stay cached for the session
+            MeshSurfaceCache.Clear();
             LoadMaterialLibrary();
-            ApplyMetadataToComponents();
+            
+            if (timeSlicedImport)
+            {
+                importRoutine = StartCoroutine(ImportBuildingRoutine());
+            }
+            else
+            {
+                IsImporting = true;
+                ApplyMetadataToComponents();
+                if (combineStaticMeshes)
+                {
+                    CombineStaticMeshes();
+                }
+                CompleteImport();
+            }
         }
         else
         {
             Debug.LogError("Building metadata not assigned. Please assign the JSON file extracted from IFC.");
+            
+            // Nothing to import; release anyone waiting on the import
+            CompleteImport();
+        }
+    }
+    
+    void OnDisable()
+    {
+        if (importCancellation == null)
+            return;
+        
+        // Deactivating the GameObject stops the import coroutine before its cleanup runs (disabling only the
+        // component would leave it running), so stop it either way and end the import here
+        if (importRoutine != null)
+        {
+            StopCoroutine(importRoutine);
+            importRoutine = null;
         }
+        
+        // Releases a worker blocked on the full queue
+        importCancellation.Cancel();
+        importCancellation.Dispose();
+        importCancellation = null;
+        combinePlans = null;
+        IsImporting = false;
+        Debug.LogWarning("Building import cancelled because the organizer was disabled");
+    }
+    
+    void OnDestroy()
+    {
+        // Stop a worker that is still parsing
+        importCancellation?.Cancel();
+        
+        spatialIndex?.Dispose();
+        spatialIndex = null;
     }
     
     /// <summary>
@@ -44,33 +184,53 @@ public class BuildingOrganizer : MonoBehaviour
     private void LoadMaterialLibrary()
     {
         BuildingPhysicsMaterial[] materials = Resources.LoadAll<BuildingPhysicsMaterial>(physicsMaterialsPath);
-        foreach (var material in materials)
-        {
-            availableMaterials[material.materialName.ToLower()] = material;
-        }
         
-        Debug.Log($"Loaded {availableMaterials.Count} building physics materials");
+        // Name, alias and category tables are built once here and reused for every component
+        materialResolver = new BuildingMaterialResolver(materials);
+        
+        Debug.Log($"Loaded {materialResolver.Count} building physics materials");
     }
     
     /// <summary>
-    /// Processes the building metadata and applies it to scene objects
+    /// Processes the building metadata and applies it to scene objects.
+    /// The JSON is streamed: storeys and spaces are kept, components are applied as they are read and then dropped.
     /// </summary>
     private void ApplyMetadataToComponents()
     {
         try
         {
-            // Parse metadata
-            data = JsonConvert.DeserializeObject<BuildingData>(buildingMetadata.text);
-            Debug.Log($"Loaded building data with {data.components.Count} components, {data.spaces.Count} spaces, and {data.building_storeys.Count} storeys");
+            data = new BuildingData();
             
-            // Create organizational hierarchy if requested
-            if (createHierarchy)
+            // Find all objects in the scene with IFC GlobalIds
+            Dictionary<string, GameObject> elementMap = FindAllIfcElements();
+            
+            // Components are applied as they are read; any that precede the spatial structure are parented once it is complete
+            BeginSpatialStructure();
+            int componentsAdded = 0;
+            
+            BuildingMetadataReader reader = new BuildingMetadataReader();
+            reader.OnProjectInfoRead += info => data.project_info = info;
+            reader.OnStoreyRead += (id, storey) => data.building_storeys[id] = storey;
+            reader.OnSpaceRead += (id, space) => data.spaces[id] = space;
+            reader.OnMaterialRead += (id, material) => data.materials[id] = material;
+            reader.OnSpatialStructureRead += () =>
             {
-                CreateBuildingHierarchy();
+                CompleteSpatialStructure();
+                ParentDeferredComponents(null, 0f);
+            };
+            reader.OnComponentRead += (id, component) =>
+            {
+                if (ApplyComponentData(id, component, elementMap))
+                    componentsAdded++;
+            };
+            
+            using (TextReader text = new StreamReader(OpenMetadataStream()))
+            {
+                reader.Read(text);
             }
             
-            // Add BuildingComponent to objects
-            AddBuildingComponentsToElements();
+            Debug.Log($"Loaded building data with {reader.ComponentCount} components, {data.spaces.Count} spaces, and {data.building_storeys.Count} storeys");
+            Debug.Log($"Added BuildingComponent to {componentsAdded} objects");
             
             // Assign materials if requested
             if (autoAssignMaterials)
@@ -84,8 +244,278 @@ public class BuildingOrganizer : MonoBehaviour
         }
     }
     
+    /// <summary>
+    /// Time-sliced import: the JSON is parsed on a worker thread into a bounded queue, while the
+    /// Unity-API work (hierarchy, AddComponent, SetParent, colliders, materials) is spread across
+    /// frames within frameBudgetMilliseconds. Progress is reported through OnImportProgress.
+    /// </summary>
+    private IEnumerator ImportBuildingRoutine()
+    {
+        IsImporting = true;
+        data = new BuildingData();
+        ReportProgress(0f, "Scanning scene");
+        yield return null;
+        
+        Dictionary<string, GameObject> elementMap = FindAllIfcElements();
+        
+        Stream metadataStream;
+        try
+        {
+            metadataStream = OpenMetadataStream();
+        }
+        catch (Exception e)
+        {
+            Debug.LogError($"Error opening building metadata: {e.Message}");
+            CompleteImport();
+            yield break;
+        }
+        
+        // Worker thread: parse and hand components over through a bounded queue, so it cannot run far ahead of the main thread
+        ImportWorker worker = new ImportWorker(data, metadataStream, Mathf.Max(1, importQueueCapacity));
+        importCancellation = new CancellationTokenSource();
+        CancellationToken cancellationToken = importCancellation.Token;
+        Task parseTask = Task.Run(() => worker.Run(cancellationToken));
+        
+        Stopwatch frameTimer = new Stopwatch();
+        BeginSpatialStructure();
+        int componentsAdded = 0;
+        
+        // Phase 1: apply components as the worker produces them; the worker never holds them back
+        while (true)
+        {
+            if (!spatialStructureReady && worker.SpatialStructureReady)
+            {
+                CompleteSpatialStructure();
+            }
+            
+            frameTimer.Restart();
+            bool parented = ParentDeferredComponents(frameTimer, frameBudgetMilliseconds);
+            while (parented && frameTimer.Elapsed.TotalMilliseconds < frameBudgetMilliseconds &&
+                   worker.Components.TryTake(out KeyValuePair<string, ComponentData> entry))
+            {
+                try
+                {
+                    if (ApplyComponentData(entry.Key, entry.Value, elementMap))
+                        componentsAdded++;
+                }
+                catch (Exception e)
+                {
+                    Debug.LogError($"Error applying component {entry.Key}: {e.Message}");
+                }
+            }
+            
+            if (worker.Components.IsCompleted && parented)
+            {
+                if (spatialStructureReady)
+                    break;
+                
+                // The worker stopped before raising the spatial structure (cancelled or failed)
+                CompleteSpatialStructure();
+                continue;
+            }
+            
+            ReportProgress(worker.Progress * 0.8f, "Importing components");
+            yield return null;
+        }
+        
+        if (parseTask.IsFaulted)
+        {
+            Exception error = parseTask.Exception.GetBaseException();
+            Debug.LogError($"Error processing building metadata: {error.Message}\n{error.StackTrace}");
+        }
+        
+        Debug.Log($"Loaded building data with {worker.ComponentCount} components, {data.spaces.Count} spaces, and {data.building_storeys.Count} storeys");
+        Debug.Log($"Added BuildingComponent to {componentsAdded} objects");
+        
+        // Phase 2: default materials
+        if (autoAssignMaterials)
+        {
+            BuildingComponent[] components = FindObjectsOfType<BuildingComponent>();
+            int materialsAssigned = 0;
+            int index = 0;
+            
+            while (index < components.Length)
+            {
+                frameTimer.Restart();
+                while (index < components.Length && frameTimer.Elapsed.TotalMilliseconds < frameBudgetMilliseconds)
+                {
+                    if (AssignDefaultMaterial(components[index]))
+                        materialsAssigned++;
+                    index++;
+                }
+                
+                ReportProgress(0.8f + 0.15f * index / components.Length, "Assigning materials");
+                yield return null;
+            }
+            
+            Debug.Log($"Assigned default materials to {materialsAssigned} components");
+        }
+        
+        // Phase 3: static mesh combining, a few chunks per frame
+        if (combineStaticMeshes)
+        {
+            frameTimer.Restart();
+            while (!CombinePlannedChunks(frameTimer, frameBudgetMilliseconds))
+            {
+                ReportProgress(0.95f + 0.05f * combinePlanIndex / combinePlans.Count, "Combining meshes");
+                yield return null;
+                frameTimer.Restart();
+            }
+        }
+        
+        importCancellation.Dispose();
+        importCancellation = null;
+        importRoutine = null;
+        CompleteImport();
+    }
+    
+    /// <summary>
+    /// Resets the spatial structure state at the start of an import
+    /// </summary>
+    private void BeginSpatialStructure()
+    {
+        spatialStructureReady = false;
+        unparentedComponents.Clear();
+        unparentedIndex = 0;
+    }
+    
+    /// <summary>
+    /// Called once storeys and spaces are known: creates the hierarchy that later components are parented into
+    /// </summary>
+    private void CompleteSpatialStructure()
+    {
+        if (createHierarchy)
+        {
+            CreateBuildingHierarchy();
+        }
+        spatialStructureReady = true;
+    }
+    
+    /// <summary>
+    /// Parents the components applied before the hierarchy existed, until the budget is used up
+    /// (no timer: all of them). Returns true once none are left.
+    /// </summary>
+    private bool ParentDeferredComponents(Stopwatch frameTimer, float budgetMilliseconds)
+    {
+        if (!spatialStructureReady)
+            return true;
+        
+        while (unparentedIndex < unparentedComponents.Count)
+        {
+            if (frameTimer != null && frameTimer.Elapsed.TotalMilliseconds >= budgetMilliseconds)
+                return false;
+            
+            BuildingComponent component = unparentedComponents[unparentedIndex++];
+            if (component != null)
+            {
+                Reparent(component.transform, component.spaceId, component.storeyId);
+            }
+        }
+        
+        unparentedComponents.Clear();
+        unparentedIndex = 0;
+        return true;
+    }
+    
+    private void ReportProgress(float progress, string stage)
+    {
+        OnImportProgress?.Invoke(progress, stage);
+    }
+    
+    private void CompleteImport()
+    {
+        // Built in the background; the first query waits for it
+        if (buildSpatialIndex)
+        {
+            RebuildSpatialIndex();
+        }
+        
+        IsImporting = false;
+        IsImportComplete = true;
+        ReportProgress(1f, "Done");
+        OnImportCompleted?.Invoke();
+    }
+    
+    /// <summary>
+    /// Parses the metadata stream on a worker thread. Storeys, spaces and materials go straight into
+    /// BuildingData; components are handed to the main thread through a bounded queue.
+    /// </summary>
+    private class ImportWorker
+    {
+        public readonly BlockingCollection<KeyValuePair<string, ComponentData>> Components;
+        
+        // Set once storeys and spaces have been read (or the document ended); the main thread only reads them afterwards
+        public bool SpatialStructureReady => Volatile.Read(ref spatialStructureReady);
+        public float Progress => streamLength > 0 ? Mathf.Clamp01((float)Volatile.Read(ref bytesRead) / streamLength) : 0f;
+        public int ComponentCount => Volatile.Read(ref componentCount);
+        
+        private readonly BuildingData data;
+        private readonly Stream stream;
+        private readonly long streamLength;
+        private bool spatialStructureReady;
+        private long bytesRead;
+        private int componentCount;
+        
+        public ImportWorker(BuildingData data, Stream stream, int capacity)
+        {
+            this.data = data;
+            this.stream = stream;
+            streamLength = stream.CanSeek ? stream.Length : 0;
+            Components = new BlockingCollection<KeyValuePair<string, ComponentData>>(capacity);
+        }
+        
+        public void Run(CancellationToken cancellationToken)
+        {
+            try
+            {
+                BuildingMetadataReader reader = new BuildingMetadataReader();
+                reader.OnProjectInfoRead += info => data.project_info = info;
+                reader.OnMaterialRead += (id, material) => data.materials[id] = material;
+                reader.OnStoreyRead += (id, storey) => data.building_storeys[id] = storey;
+                reader.OnSpaceRead += (id, space) => data.spaces[id] = space;
+                reader.OnSpatialStructureRead += () => Volatile.Write(ref spatialStructureReady, true);
+                reader.OnComponentRead += (id, component) =>
+                {
+                    cancellationToken.ThrowIfCancellationRequested();
+                    Interlocked.Increment(ref componentCount);
+                    Volatile.Write(ref bytesRead, stream.Position);
+                    
+                    // Passed on even before the spatial structure is read; the main thread parents those later
+                    Components.Add(new KeyValuePair<string, ComponentData>(id, component), cancellationToken);
+                };
+                
+                using (TextReader text = new StreamReader(stream))
+                {
+                    reader.Read(text);
+                }
+            }
+            finally
+            {
+                Components.CompleteAdding();
+            }
+        }
+    }
+    
+    /// <summary>
+    /// Opens the metadata source, preferring the on-disk file over the TextAsset. Main thread only.
+    /// </summary>
+    private Stream OpenMetadataStream()
+    {
+        if (!string.IsNullOrEmpty(metadataFilePath))
+        {
+            string path = Path.IsPathRooted(metadataFilePath)
+                ? metadataFilePath
+                : Path.Combine(Application.streamingAssetsPath, metadataFilePath);
+            return BuildingMetadataReader.OpenFile(path);
+        }
+        
+        // TextAsset.bytes is the raw UTF-8 payload; TextAsset.text would add a UTF-16 copy of the whole file
+        return BuildingMetadataReader.OpenBytes(buildingMetadata.bytes);
+    }
+    
     /// <summary>
     /// Creates a hierarchical structure in the scene matching the IFC spatial structure
+    /// and indexes the storey/space transforms by GlobalId for later parenting
     /// </summary>
     private void CreateBuildingHierarchy()
     {
@@ -95,6 +525,12 @@ public class BuildingOrganizer : MonoBehaviour
             buildingRoot = root.transform;
         }
         
+        storeyTransforms.Clear();
+        spaceTransforms.Clear();
+        
+        // Resolve pre-existing storey/space objects with a single scene pass instead of one GameObject.Find per entry
+        Dictionary<string, GameObject> existingObjects = FindExistingObjectsByName();
+        
         // Create GameObject for each storey
         foreach (var storeyEntry in data.building_storeys)
         {
@@ -102,8 +538,7 @@ public class BuildingOrganizer : MonoBehaviour
             StoreyData storeyData = storeyEntry.Value;
             
             // Create or find storey GameObject
-            GameObject storeyObject = GameObject.Find(storeyData.name);
-            if (storeyObject == null)
+            if (!existingObjects.TryGetValue(storeyData.name ?? string.Empty, out GameObject storeyObject))
             {
                 storeyObject = new GameObject(storeyData.name);
                 storeyObject.transform.SetParent(buildingRoot);
@@ -113,8 +548,13 @@ public class BuildingOrganizer : MonoBehaviour
             }
             
             // Add custom component to store GlobalId
-            StoreyIdentifier identifier = storeyObject.AddComponent<StoreyIdentifier>();
+            StoreyIdentifier identifier = storeyObject.GetComponent<StoreyIdentifier>();
+            if (identifier == null)
+            {
+                identifier = storeyObject.AddComponent<StoreyIdentifier>();
+            }
             identifier.globalId = storeyId;
+            storeyTransforms[storeyId] = storeyObject.transform;
             
             // Create GameObject for each space in this storey
             foreach (string spaceId in storeyData.contained_spaces)
@@ -122,86 +562,218 @@ public class BuildingOrganizer : MonoBehaviour
                 if (data.spaces.TryGetValue(spaceId, out SpaceData spaceData))
                 {
                     // Create or find space GameObject
-                    string spaceName = string.IsNullOrEmpty(spaceData.long_name) ? spaceData.name : spaceData.long_name;
-                    GameObject spaceObject = GameObject.Find(spaceName);
-                    if (spaceObject == null)
+                    string spaceName = GetSpaceObjectName(spaceData);
+                    if (!existingObjects.TryGetValue(spaceName ?? string.Empty, out GameObject spaceObject))
                     {
                         spaceObject = new GameObject(spaceName);
                         spaceObject.transform.SetParent(storeyObject.transform);
                     }
                     
                     // Add custom component to store GlobalId
-                    SpaceIdentifier spaceIdentifier = spaceObject.AddComponent<SpaceIdentifier>();
+                    SpaceIdentifier spaceIdentifier = spaceObject.GetComponent<SpaceIdentifier>();
+                    if (spaceIdentifier == null)
+                    {
+                        spaceIdentifier = spaceObject.AddComponent<SpaceIdentifier>();
+                    }
                     spaceIdentifier.globalId = spaceId;
+                    spaceTransforms[spaceId] = spaceObject.transform;
                 }
             }
         }
     }
     
     /// <summary>
-    /// Adds BuildingComponent components to objects in the scene based on their IFC GlobalId
+    /// Collects the scene objects whose names match a storey or space in the metadata.
+    /// The first object found for a name wins, mirroring GameObject.Find.
     /// </summary>
-    private void AddBuildingComponentsToElements()
+    private Dictionary<string, GameObject> FindExistingObjectsByName()
     {
-        // Find all objects in the scene with IFC GlobalIds
-        Dictionary<string, GameObject> elementMap = FindAllIfcElements();
-        int componentsAdded = 0;
+        HashSet<string> wantedNames = new HashSet<string>();
+        foreach (var storeyData in data.building_storeys.Values)
+        {
+            if (!string.IsNullOrEmpty(storeyData.name))
+                wantedNames.Add(storeyData.name);
+        }
+        foreach (var spaceData in data.spaces.Values)
+        {
+            string spaceName = GetSpaceObjectName(spaceData);
+            if (!string.IsNullOrEmpty(spaceName))
+                wantedNames.Add(spaceName);
+        }
+        
+        Dictionary<string, GameObject> existingObjects = new Dictionary<string, GameObject>();
+        if (wantedNames.Count == 0)
+            return existingObjects;
         
-        foreach (var entry in data.components)
+        foreach (Transform sceneTransform in FindObjectsOfType<Transform>())
         {
-            string globalId = entry.Key;
-            ComponentData componentData = entry.Value;
-            
-            // Skip elements that don't match an object in the scene
-            if (!elementMap.TryGetValue(globalId, out GameObject elementObject))
-            {
-                continue;
-            }
-            
-            // Add BuildingComponent if not already present
-            BuildingComponent buildingComponent = elementObject.GetComponent<BuildingComponent>();
-            if (buildingComponent == null)
+            string objectName = sceneTransform.name;
+            if (wantedNames.Contains(objectName) && !existingObjects.ContainsKey(objectName))
             {
-                buildingComponent = elementObject.AddComponent<BuildingComponent>();
-                componentsAdded++;
+                existingObjects.Add(objectName, sceneTransform.gameObject);
             }
+        }
+        
+        return existingObjects;
+    }
+    
+    private static string GetSpaceObjectName(SpaceData spaceData)
+    {
+        return string.IsNullOrEmpty(spaceData.long_name) ? spaceData.name : spaceData.long_name;
+    }
+    
+    /// <summary>
+    /// Returns the transform created for a storey, or null if the storey is not in the hierarchy
+    /// </summary>
+    public Transform GetStoreyTransform(string storeyId)
+    {
+        if (string.IsNullOrEmpty(storeyId))
+            return null;
+        
+        storeyTransforms.TryGetValue(storeyId, out Transform storeyTransform);
+        return storeyTransform;
+    }
+    
+    /// <summary>
+    /// Merges the static elements that are not combined yet into per-storey, per-material meshes.
+    /// Returns the number of components now drawn by combined meshes.
+    /// </summary>
+    public int CombineStaticMeshes()
+    {
+        CombinePlannedChunks(null, 0f);
+        return combinedComponentCount;
+    }
+    
+    /// <summary>
+    /// Plans the chunks on the first call, then builds them until the budget is used up (no timer: all of them).
+    /// Returns true once all are built.
+    /// </summary>
+    private bool CombinePlannedChunks(Stopwatch frameTimer, float budgetMilliseconds)
+    {
+        if (combinePlans == null)
+        {
+            combinePlans = BuildingMeshCombiner.Plan(FindObjectsOfType<BuildingComponent>(), maxVerticesPerChunk);
+            combinePlanIndex = 0;
+            combinedComponentCount = 0;
+        }
+        
+        // At least one chunk per call, so a tiny budget still makes progress
+        while (combinePlanIndex < combinePlans.Count)
+        {
+            combinedComponentCount += BuildCombinedChunk(combinePlans[combinePlanIndex++]);
             
-            // Set the component properties
-            buildingComponent.globalId = globalId;
-            buildingComponent.elementName = componentData.name;
-            buildingComponent.ifcType = componentData.type;
-            buildingComponent.storeyId = componentData.storey_id;
-            buildingComponent.spaceId = componentData.space_id;
-            
-            // Copy properties
-            if (componentData.properties != null)
-            {
-                foreach (var prop in componentData.properties)
-                {
-                    buildingComponent.SetProperty(prop.Key, prop.Value);
-                }
-            }
+            if (frameTimer != null && frameTimer.Elapsed.TotalMilliseconds >= budgetMilliseconds && combinePlanIndex < combinePlans.Count)
+                return false;
+        }
+        
+        Debug.Log($"Combined {combinedComponentCount} components into {combinedChunks.Count} meshes");
+        combinePlans = null;
+        return true;
+    }
+    
+    /// <summary>
+    /// Rebuilds the spatial index from the components in the scene, e.g. after elements were moved or meshes edited
+    /// </summary>
+    public void RebuildSpatialIndex()
+    {
+        spatialIndex?.Dispose();
+        spatialIndex = new ComponentSpatialIndex(FindObjectsOfType<BuildingComponent>(), Spaces);
+    }
+    
+    /// <summary>
+    /// Builds a planned chunk under its storey, falling back to the building root
+    /// </summary>
+    private int BuildCombinedChunk(BuildingMeshCombiner.ChunkPlan plan)
+    {
+        Transform parent = GetStoreyTransform(plan.storeyId);
+        if (parent == null)
+        {
+            parent = buildingRoot != null ? buildingRoot : transform;
+        }
+        
+        CombinedMeshChunk chunk = BuildingMeshCombiner.Build(plan, parent);
+        if (chunk == null)
+            return 0;
+        
+        combinedChunks.Add(chunk);
+        return chunk.ComponentCount;
+    }
+    
+    /// <summary>
+    /// Returns the transform created for a space, or null if the space is not in the hierarchy
+    /// </summary>
+    public Transform GetSpaceTransform(string spaceId)
+    {
+        if (string.IsNullOrEmpty(spaceId))
+            return null;
+        
+        spaceTransforms.TryGetValue(spaceId, out Transform spaceTransform);
+        return spaceTransform;
+    }
+    
+    /// <summary>
+    /// Adds a BuildingComponent to the scene object matching a component's IFC GlobalId.
+    /// Returns true if a new BuildingComponent was added.
+    /// </summary>
+    private bool ApplyComponentData(string globalId, ComponentData componentData, Dictionary<string, GameObject> elementMap)
+    {
+        // Skip elements that don't match an object in the scene
+        if (!elementMap.TryGetValue(globalId, out GameObject elementObject))
+        {
+            return false;
+        }
+        
+        // Add BuildingComponent if not already present
+        bool added = false;
+        BuildingComponent buildingComponent = elementObject.GetComponent<BuildingComponent>();
+        if (buildingComponent == null)
+        {
+            buildingComponent = elementObject.AddComponent<BuildingComponent>();
+            added = true;
+        }
             
-            // Handle material layers if present
-            if (componentData.materials != null && componentData.materials.Count > 0)
+        // Set the component properties
+        buildingComponent.globalId = globalId;
+        buildingComponent.elementName = componentData.name;
+        buildingComponent.ifcType = componentData.type;
+        buildingComponent.storeyId = componentData.storey_id;
+        buildingComponent.spaceId = componentData.space_id;
+        
+        // Copy properties
+        if (componentData.properties != null)
+        {
+            foreach (var prop in componentData.properties)
             {
-                ProcessMaterialLayers(buildingComponent, componentData.materials);
+                buildingComponent.SetProperty(prop.Key, prop.Value);
             }
-            
-            // Reorganize in hierarchy if requested
-            if (createHierarchy)
+        }
+        
+        // Handle material layers if present
+        if (componentData.materials != null && componentData.materials.Count > 0)
+        {
+            ProcessMaterialLayers(buildingComponent, componentData.materials);
+        }
+        
+        // Reorganize in hierarchy if requested, or once it exists
+        if (createHierarchy)
+        {
+            if (spatialStructureReady)
             {
                 OrganizeInHierarchy(elementObject, componentData);
             }
-            
-            // Add collider if needed
-            if (addMissingColliders && elementObject.GetComponent<Collider>() == null)
+            else
             {
-                AddAppropriateCollider(elementObject, componentData.type);
+                unparentedComponents.Add(buildingComponent);
             }
         }
         
-        Debug.Log($"Added BuildingComponent to {componentsAdded} objects");
+        // Add collider if needed
+        if (addMissingColliders && elementObject.GetComponent<Collider>() == null)
+        {
+            AddAppropriateCollider(elementObject, componentData.type, componentData.storey_id);
+        }
+        
+        return added;
     }
     
     /// <summary>
@@ -264,7 +836,7 @@ public class BuildingOrganizer : MonoBehaviour
         foreach (MeshRenderer renderer in GameObject.FindObjectsOfType<MeshRenderer>())
         {
             GameObject obj = renderer.gameObject;
-            string globalId = ExtractGlobalIdFromObject(obj);
+            string globalId = GlobalIdResolver.Resolve(obj);
             
             if (!string.IsNullOrEmpty(globalId))
             {
@@ -277,143 +849,99 @@ public class BuildingOrganizer : MonoBehaviour
     }
     
     /// <summary>
-    /// Extracts GlobalId from a GameObject using various methods
+    /// Assigns default physics materials based on IFC type
     /// </summary>
-    private string ExtractGlobalIdFromObject(GameObject obj)
+    private void AssignDefaultMaterials()
     {
-        // Method 1: Check custom properties directly on the GameObject
-        if (obj.TryGetComponent<MonoBehaviour>(out var monoBehaviour))
-        {
-            // Try direct property
-            System.Reflection.PropertyInfo globalIdProperty = monoBehaviour.GetType().GetProperty("GlobalId");
-            if (globalIdProperty != null)
-            {
-                string id = globalIdProperty.GetValue(monoBehaviour) as string;
-                if (!string.IsNullOrEmpty(id))
-                {
-                    return id;
-                }
-            }
-            
-            // Try field
-            System.Reflection.FieldInfo globalIdField = monoBehaviour.GetType().GetField("GlobalId");
-            if (globalIdField != null)
-            {
-                string id = globalIdField.GetValue(monoBehaviour) as string;
-                if (!string.IsNullOrEmpty(id))
-                {
-                    return id;
-                }
-            }
-        }
-        
-        // Method 2: Check for GlobalId in the name (like "ElementName [GlobalId]")
-        string name = obj.name;
-        int startBracket = name.IndexOf('[');
-        int endBracket = name.IndexOf(']');
-        
-        if (startBracket >= 0 && endBracket > startBracket)
-        {
-            return name.Substring(startBracket + 1, endBracket - startBracket - 1);
-        }
+        BuildingComponent[] components = GameObject.FindObjectsOfType<BuildingComponent>();
+        int materialsAssigned = 0;
         
-        // Method 3: Check for GlobalId_Name pattern
-        int underscore = name.IndexOf('_');
-        if (underscore > 0 && underscore < name.Length - 1)
+        foreach (var component in components)
         {
-            string potentialId = name.Substring(0, underscore);
-            // IFC GlobalIds are typically 22 characters
-            if (potentialId.Length == 22 && !potentialId.Contains(" "))
+            if (AssignDefaultMaterial(component))
             {
-                return potentialId;
+                materialsAssigned++;
             }
         }
         
-        return null;
+        Debug.Log($"Assigned default materials to {materialsAssigned} components");
     }
     
     /// <summary>
-    /// Assigns default physics materials based on IFC type
+    /// Assigns default physics materials to one component. Returns true if any material was assigned.
     /// </summary>
-    private void AssignDefaultMaterials()
+    private bool AssignDefaultMaterial(BuildingComponent component)
     {
-        BuildingComponent[] components = GameObject.FindObjectsOfType<BuildingComponent>();
-        int materialsAssigned = 0;
+        bool wasAssigned = false;
         
-        foreach (var component in components)
+        // Skip if already has material
+        if (component.isMultiLayer)
         {
-            bool wasAssigned = false;
-            
-            // Skip if already has material
-            if (component.isMultiLayer)
+            bool allLayersHaveMaterials = true;
+            foreach (var layer in component.materialLayers)
             {
-                bool allLayersHaveMaterials = true;
-                foreach (var layer in component.materialLayers)
-                {
-                    if (layer.material == null)
-                    {
-                        allLayersHaveMaterials = false;
-                        break;
-                    }
-                }
-                
-                if (allLayersHaveMaterials)
+                if (layer.material == null)
                 {
-                    continue; // Skip if all layers already have materials
+                    allLayersHaveMaterials = false;
+                    break;
                 }
             }
-            else if (component.currentMaterial != null)
+            
+            if (allLayersHaveMaterials)
             {
-                continue; // Skip if single-layer already has material
+                return false; // Skip if all layers already have materials
             }
-            
-            // Assign materials based on IFC type
-            if (component.isMultiLayer)
+        }
+        else if (component.currentMaterial != null)
+        {
+            return false; // Skip if single-layer already has material
+        }
+        
+        // Assign materials based on IFC type
+        if (component.isMultiLayer)
+        {
+            // Multi-layer approach
+            for (int i = 0; i < component.materialLayers.Count; i++)
             {
-                // Multi-layer approach
-                for (int i = 0; i < component.materialLayers.Count; i++)
+                var layer = component.materialLayers[i];
+                if (layer.material == null)
                 {
-                    var layer = component.materialLayers[i];
+                    // Find material by name first
+                    layer.material = FindMaterialByName(layer.name);
+                    
+                    // If not found, assign default for this layer position
                     if (layer.material == null)
                     {
-                        // Find material by name first
-                        layer.material = FindMaterialByName(layer.name);
-                        
-                        // If not found, assign default for this layer position
-                        if (layer.material == null)
-                        {
-                            layer.material = GetDefaultMaterialForLayerInType(i, component.materialLayers.Count, component.ifcType);
-                            if (layer.material != null)
-                            {
-                                wasAssigned = true;
-                            }
-                        }
-                        else
+                        layer.material = GetDefaultMaterialForLayerInType(i, component.materialLayers.Count, component.ifcType);
+                        if (layer.material != null)
                         {
                             wasAssigned = true;
                         }
                     }
+                    else
+                    {
+                        wasAssigned = true;
+                    }
                 }
             }
-            else
-            {
-                // Single material
-                component.currentMaterial = GetDefaultMaterialForType(component.ifcType);
-                if (component.currentMaterial != null)
-                {
-                    wasAssigned = true;
-                }
-            }
-            
-            if (wasAssigned)
+        }
+        else
+        {
+            // Single material
+            component.currentMaterial = GetDefaultMaterialForType(component.ifcType);
+            if (component.currentMaterial != null)
             {
-                // Update visuals
-                component.UpdateVisuals();
-                materialsAssigned++;
+                wasAssigned = true;
             }
         }
         
-        Debug.Log($"Assigned default materials to {materialsAssigned} components");
+        if (wasAssigned)
+        {
+            // Update visuals
+            component.UpdateVisuals();
+        }
+        
+        return wasAssigned;
     }
     
     /// <summary>
@@ -421,68 +949,7 @@ public class BuildingOrganizer : MonoBehaviour
     /// </summary>
     private BuildingPhysicsMaterial FindMaterialByName(string materialName)
     {
-        if (string.IsNullOrEmpty(materialName))
-            return null;
-            
-        string lowerName = materialName.ToLower();
-        
-        // Try exact match
-        if (availableMaterials.TryGetValue(lowerName, out BuildingPhysicsMaterial material))
-        {
-            return material;
-        }
-        
-        // Try common abbreviations and variants
-        Dictionary<string, string> commonVariants = new Dictionary<string, string>
-        {
-            {"concrete", "concrete"},
-            {"conc", "concrete"},
-            {"brick", "brick"},
-            {"masonry", "brick"},
-            {"glass", "glass"},
-            {"glazing", "glass"},
-            {"window", "glass"},
-            {"steel", "steel"},
-            {"metal", "steel"},
-            {"aluminum", "aluminum"},
-            {"aluminium", "aluminum"},
-            {"timber", "wood"},
-            {"wood", "wood"},
-            {"insulation", "glasswool"},
-            {"insul", "glasswool"},
-            {"gypsum", "gypsum"},
-            {"plaster", "gypsum"},
-            {"drywall", "gypsum"},
-            {"tile", "ceramictile"},
-            {"ceramic", "ceramictile"},
-            {"stone", "stone"},
-            {"marble", "stone"},
-            {"granite", "stone"},
-            {"roof", "roof"}
-        };
-        
-        foreach (var variant in commonVariants)
-        {
-            if (lowerName.Contains(variant.Key))
-            {
-                // Try to find material with standardized name
-                if (availableMaterials.TryGetValue(variant.Value, out material))
-                {
-                    return material;
-                }
-                
-                // Try to find any material in that category
-                foreach (var entry in availableMaterials)
-                {
-                    if (entry.Value.category.ToLower() == variant.Value)
-                    {
-                        return entry.Value;
-                    }
-                }
-            }
-        }
-        
-        return null;
+        return materialResolver?.FindByName(materialName);
     }
     
     /// <summary>
@@ -490,63 +957,35 @@ public class BuildingOrganizer : MonoBehaviour
     /// </summary>
     private BuildingPhysicsMaterial GetDefaultMaterialForType(string ifcType)
     {
-        string lowerType = ifcType.ToLower();
-        
-        if (lowerType.Contains("ifcwall"))
-        {
-            return FindMaterialByCategory("Wall") ?? FindMaterialByCategory("Concrete");
-        }
-        else if (lowerType.Contains("ifcwindow"))
-        {
-            return FindMaterialByCategory("Glass");
-        }
-        else if (lowerType.Contains("ifcslab") && lowerType.Contains("floor"))
-        {
-            return FindMaterialByCategory("Floor") ?? FindMaterialByCategory("Concrete");
-        }
-        else if (lowerType.Contains("ifcslab") && lowerType.Contains("roof"))
-        {
-            return FindMaterialByCategory("Roof");
-        }
-        else if (lowerType.Contains("ifcslab"))
-        {
-            return FindMaterialByCategory("Concrete");
-        }
-        else if (lowerType.Contains("ifcdoor"))
-        {
-            return FindMaterialByCategory("Door") ?? FindMaterialByCategory("Wood");
-        }
-        else if (lowerType.Contains("ifccolumn") || lowerType.Contains("ifcbeam"))
-        {
-            return FindMaterialByCategory("Concrete") ?? FindMaterialByCategory("Metal");
-        }
-        else if (lowerType.Contains("ifcroof"))
-        {
-            return FindMaterialByCategory("Roof");
-        }
-        else if (lowerType.Contains("ifcstair"))
-        {
-            return FindMaterialByCategory("Concrete");
-        }
-        else if (lowerType.Contains("ifcrailing"))
-        {
-            return FindMaterialByCategory("Metal");
-        }
-        else if (lowerType.Contains("ifcfurnishingelement"))
+        switch (IfcElementClassifier.Classify(ifcType))
         {
-            return FindMaterialByCategory("Wood");
+            case IfcElementKind.Wall:
+                return FindMaterialByCategory("Wall") ?? FindMaterialByCategory("Concrete");
+            case IfcElementKind.Window:
+                return FindMaterialByCategory("Glass");
+            case IfcElementKind.FloorSlab:
+                return FindMaterialByCategory("Floor") ?? FindMaterialByCategory("Concrete");
+            case IfcElementKind.RoofSlab:
+                return FindMaterialByCategory("Roof");
+            case IfcElementKind.Slab:
+                return FindMaterialByCategory("Concrete");
+            case IfcElementKind.Door:
+                return FindMaterialByCategory("Door") ?? FindMaterialByCategory("Wood");
+            case IfcElementKind.Column:
+            case IfcElementKind.Beam:
+                return FindMaterialByCategory("Concrete") ?? FindMaterialByCategory("Metal");
+            case IfcElementKind.Roof:
+                return FindMaterialByCategory("Roof");
+            case IfcElementKind.Stair:
+                return FindMaterialByCategory("Concrete");
+            case IfcElementKind.Railing:
+                return FindMaterialByCategory("Metal");
+            case IfcElementKind.Furnishing:
+                return FindMaterialByCategory("Wood");
         }
         
         // Default fallback
-        foreach (var material in availableMaterials.Values)
-        {
-            if (material.category == "General")
-            {
-                return material;
-            }
-        }
-        
-        return null;
+        return FindMaterialByCategory("General");
     }
     
     /// <summary>
@@ -554,55 +993,32 @@ public class BuildingOrganizer : MonoBehaviour
     /// </summary>
     private BuildingPhysicsMaterial GetDefaultMaterialForLayerInType(int layerIndex, int totalLayers, string ifcType)
     {
-        string lowerType = ifcType.ToLower();
-        
-        // Exterior wall layers
-        if (lowerType.Contains("ifcwall"))
-        {
-            if (layerIndex == 0) // Exterior layer
-            {
-                return FindMaterialByCategory("Wall") ?? FindMaterialByCategory("Brick");
-            }
-            else if (layerIndex == totalLayers - 1) // Interior layer
-            {
-                return FindMaterialByCategory("Gypsum");
-            }
-            else // Middle layers
-            {
-                return FindMaterialByCategory("Insulation");
-            }
-        }
-        // Roof layers
-        else if (lowerType.Contains("ifcroof") || (lowerType.Contains("ifcslab") && lowerType.Contains("roof")))
+        switch (IfcElementClassifier.Classify(ifcType))
         {
-            if (layerIndex == 0) // Exterior layer
-            {
-                return FindMaterialByCategory("Roof");
-            }
-            else if (layerIndex == totalLayers - 1) // Interior layer
-            {
-                return FindMaterialByCategory("Gypsum");
-            }
-            else // Middle layers
-            {
-                return FindMaterialByCategory("Insulation");
-            }
-        }
-        // Floor layers
-        else if (lowerType.Contains("ifcslab") && lowerType.Contains("floor"))
-        {
-            if (layerIndex == 0) // Top layer
-            {
-                return FindMaterialByCategory("Floor");
-            }
-            else if (layerIndex == totalLayers - 1) // Bottom layer
-            {
-                return FindMaterialByCategory("Concrete");
-            }
-            else // Middle layers
-            {
-                return FindMaterialByCategory("Insulation");
-            }
+            // Exterior wall layers
+            case IfcElementKind.Wall:
+                if (layerIndex == 0) // Exterior layer
+                    return FindMaterialByCategory("Wall") ?? FindMaterialByCategory("Brick");
+                if (layerIndex == totalLayers - 1) // Interior layer
+                    return FindMaterialByCategory("Gypsum");
+                return FindMaterialByCategory("Insulation"); // Middle layers
+        
+            // Roof layers
+            case IfcElementKind.Roof:
+            case IfcElementKind.RoofSlab:
+                if (layerIndex == 0) // Exterior layer
+                    return FindMaterialByCategory("Roof");
+                if (layerIndex == totalLayers - 1) // Interior layer
+                    return FindMaterialByCategory("Gypsum");
+                return FindMaterialByCategory("Insulation"); // Middle layers
+            
+            // Floor layers
+            case IfcElementKind.FloorSlab:
+                if (layerIndex == 0) // Top layer
+                    return FindMaterialByCategory("Floor");
+                if (layerIndex == totalLayers - 1) // Bottom layer
+                    return FindMaterialByCategory("Concrete");
+                return FindMaterialByCategory("Insulation"); // Middle layers
         }
         
         // Default case
@@ -610,24 +1026,31 @@ public class BuildingOrganizer : MonoBehaviour
     }
     
     /// <summary>
-    /// Finds a material by category
+    /// Finds a material by category (case-insensitive index lookup)
     /// </summary>
     private BuildingPhysicsMaterial FindMaterialByCategory(string category)
     {
-        foreach (var material in availableMaterials.Values)
+        return materialResolver?.FindByCategory(category);
+    }
+    
+    private MeshColliderBaker GetColliderBaker()
+    {
+        if (colliderBaker == null)
         {
-            if (material.category.ToLower() == category.ToLower())
+            colliderBaker = GetComponent<MeshColliderBaker>();
+            if (colliderBaker == null)
             {
-                return material;
+                colliderBaker = gameObject.AddComponent<MeshColliderBaker>();
             }
+            colliderBaker.organizer = this;
         }
-        return null;
+        return colliderBaker;
     }
     
     /// <summary>
     /// Adds the appropriate collider type based on element type
     /// </summary>
-    private void AddAppropriateCollider(GameObject obj, string ifcType)
+    private void AddAppropriateCollider(GameObject obj, string ifcType, string storeyId)
     {
         // Check if the object has a mesh
         MeshFilter meshFilter = obj.GetComponent<MeshFilter>();
@@ -636,37 +1059,89 @@ public class BuildingOrganizer : MonoBehaviour
             return;
         }
         
-        string lowerType = ifcType.ToLower();
+        IfcElementKind kind = IfcElementClassifier.Classify(ifcType);
         
-        // Use mesh collider for most building elements
-        if (lowerType.Contains("ifcwall") || 
-            lowerType.Contains("ifcslab") || 
-            lowerType.Contains("ifcroof") ||
-            lowerType.Contains("ifcstair"))
+        // Walls are the bulk of the cooking cost and are picked through the spatial index. A wall that is
+        // a plain box gets a BoxCollider, which needs no cooking; walls with openings keep a MeshCollider,
+        // since a box would close their doorways and windows.
+        if (kind == IfcElementKind.Wall && !addWallMeshColliders && IsBoxMesh(meshFilter.sharedMesh))
         {
-            if (obj.GetComponent<MeshCollider>() == null)
+            if (obj.GetComponent<Collider>() == null)
             {
-                MeshCollider collider = obj.AddComponent<MeshCollider>();
+                obj.AddComponent<BoxCollider>();
+            }
+            return;
+        }
+        
+        switch (kind)
+        {
+            // Use mesh collider for most building elements
+            case IfcElementKind.Wall:
+            case IfcElementKind.Slab:
+            case IfcElementKind.FloorSlab:
+            case IfcElementKind.RoofSlab:
+            case IfcElementKind.Roof:
+            case IfcElementKind.Stair:
+                if (obj.GetComponent<MeshCollider>() == null)
+                {
+                    // Cooked off the main thread and attached once ready (MeshColliderBaker)
+                    if (deferMeshColliders && GetColliderBaker().Enqueue(obj, meshFilter.sharedMesh, storeyId))
+                        break;
+                    
+                    MeshCollider collider = obj.AddComponent<MeshCollider>();
                 
-                // Make stairs non-convex for proper stepping
-                if (lowerType.Contains("ifcstair"))
+                    // Make stairs non-convex for proper stepping
+                    if (kind == IfcElementKind.Stair)
+                    {
+                        collider.convex = false;
+                    }
+                }
+                break;
+            
+            // Use box collider for simpler elements
+            case IfcElementKind.Column:
+            case IfcElementKind.Beam:
+            case IfcElementKind.Furnishing:
+            case IfcElementKind.Door:
+            case IfcElementKind.Window:
+                if (obj.GetComponent<Collider>() == null)
                 {
-                    collider.convex = false;
+                    obj.AddComponent<BoxCollider>();
                 }
-            }
+                break;
         }
-        // Use box collider for simpler elements
-        else if (lowerType.Contains("ifccolumn") || 
-                lowerType.Contains("ifcbeam") ||
-                lowerType.Contains("ifcfurnishingelement") ||
-                lowerType.Contains("ifcdoor") ||
-                lowerType.Contains("ifcwindow"))
+    }
+    
+    /// <summary>
+    /// True if every vertex lies on a corner of the mesh bounds, i.e. the mesh is exactly its own bounding box.
+    /// Openings, recesses and walls not aligned to their local axes all add vertices elsewhere.
+    /// </summary>
+    private bool IsBoxMesh(Mesh mesh)
+    {
+        if (!mesh.isReadable)
+            return false;
+        
+        const float tolerance = 0.001f;
+        Vector3 min = mesh.bounds.min;
+        Vector3 max = mesh.bounds.max;
+        
+        mesh.GetVertices(colliderVertices);
+        bool box = colliderVertices.Count > 0;
+        for (int i = 0; box && i < colliderVertices.Count; i++)
         {
-            if (obj.GetComponent<Collider>() == null)
+            Vector3 vertex = colliderVertices[i];
+            for (int axis = 0; axis < 3; axis++)
             {
-                obj.AddComponent<BoxCollider>();
+                if (Mathf.Abs(vertex[axis] - min[axis]) > tolerance && Mathf.Abs(vertex[axis] - max[axis]) > tolerance)
+                {
+                    box = false;
+                    break;
+                }
             }
         }
+        
+        colliderVertices.Clear();
+        return box;
     }
     
     /// <summary>
@@ -674,39 +1149,29 @@ public class BuildingOrganizer : MonoBehaviour
     /// </summary>
     private void OrganizeInHierarchy(GameObject elementObject, ComponentData componentData)
     {
-        // Check if it should be under a storey or space
-        if (!string.IsNullOrEmpty(componentData.space_id))
+        Reparent(elementObject.transform, componentData.space_id, componentData.storey_id);
+    }
+    
+    /// <summary>
+    /// Re-parents an element under its space, falling back to its storey and then the building root.
+    /// Lookups go through the GlobalId index, so this is constant time per element.
+    /// </summary>
+    public void Reparent(Transform element, string spaceId, string storeyId)
+    {
+        // Explicit null checks rather than ?? so destroyed Unity objects are treated as missing
+        Transform parent = GetSpaceTransform(spaceId);
+        if (parent == null)
         {
-            // Try to find space GameObject
-            SpaceIdentifier[] spaces = FindObjectsOfType<SpaceIdentifier>();
-            foreach (var space in spaces)
-            {
-                if (space.globalId == componentData.space_id)
-                {
-                    elementObject.transform.SetParent(space.transform);
-                    return;
-                }
-            }
+            parent = GetStoreyTransform(storeyId);
         }
-        
-        if (!string.IsNullOrEmpty(componentData.storey_id))
+        if (parent == null)
         {
-            // Try to find storey GameObject
-            StoreyIdentifier[] storeys = FindObjectsOfType<StoreyIdentifier>();
-            foreach (var storey in storeys)
-            {
-                if (storey.globalId == componentData.storey_id)
-                {
-                    elementObject.transform.SetParent(storey.transform);
-                    return;
-                }
-            }
+            parent = buildingRoot;
         }
         
-        // If no specific parent found, put under building root
-        if (buildingRoot != null)
+        if (parent != null && element.parent != parent)
         {
-            elementObject.transform.SetParent(buildingRoot);
+            element.SetParent(parent);
         }
     }
     
@@ -781,6 +1246,7 @@ public class BuildingOrganizer : MonoBehaviour
         public string space_id;
         public Dictionary<string, string> properties = new Dictionary<string, string>();
         public List<MaterialData> materials = new List<MaterialData>();
+        // Not populated by BuildingMetadataReader; geometry is skipped during streaming import
         public Dictionary<string, object> geometry = new Dictionary<string, object>();
     }
     
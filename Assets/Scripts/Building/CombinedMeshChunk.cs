@@ -0,0 +1,280 @@
+using UnityEngine;
+using UnityEngine.Rendering;
+using System.Collections.Generic;
+using Unity.Collections;
+
+/// <summary>
+/// One combined mesh drawing many static BuildingComponents that share a storey and appearance.
+/// Each component owns a contiguous vertex and index range; a second vertex stream (TEXCOORD3) holds its
+/// state index + 1 (0 = none) so the heatmap shader can resolve per-component values without a
+/// property block. A component whose appearance departs from the chunk (highlight, material change) is
+/// detached: its index range is collapsed to degenerate triangles and its own renderer takes over.
+/// It is reattached by restoring the range once it matches again. Created by BuildingMeshCombiner.
+/// </summary>
+[RequireComponent(typeof(MeshFilter), typeof(MeshRenderer))]
+public class CombinedMeshChunk : MonoBehaviour
+{
+    private struct ComponentRange
+    {
+        public BuildingComponent component;
+        public int vertexStart;
+        public int vertexCount;
+        public int indexStart;
+        public int indexCount;
+        public bool attached;
+    }
+    
+    private const MeshUpdateFlags PartialUpdateFlags =
+        MeshUpdateFlags.DontValidateIndices | MeshUpdateFlags.DontRecalculateBounds |
+        MeshUpdateFlags.DontResetBoneBounds | MeshUpdateFlags.DontNotifyMeshUsers;
+    
+    private static readonly int BaseColorId = Shader.PropertyToID("_BaseColor"); // URP
+    private static readonly int ColorId = Shader.PropertyToID("_Color");         // Built-in
+    private static MaterialPropertyBlock propertyBlock;
+    
+    public string storeyId;
+    
+    private Mesh mesh;
+    private MeshRenderer meshRenderer;
+    private Material baseMaterial;
+    private Color? baseTint;
+    private Material heatmapMaterial;
+    
+    // Ranges in mesh order, so a triangle resolves to its component by binary search on indexStart
+    private readonly List<ComponentRange> ranges = new List<ComponentRange>();
+    private readonly Dictionary<BuildingComponent, int> slots = new Dictionary<BuildingComponent, int>();
+    
+    // Original indices (for reattaching) and the component ID stream
+    private NativeArray<ushort> indices;
+    private NativeArray<float> componentIds;
+    private bool componentIdsDirty = false;
+    
+    public Mesh Mesh => mesh;
+    public Material BaseMaterial => baseMaterial;
+    public int ComponentCount => slots.Count;
+    public int AttachedCount { get; private set; }
+    
+    private Material CurrentMaterial => heatmapMaterial != null ? heatmapMaterial : baseMaterial;
+    private Color? CurrentTint => heatmapMaterial != null ? null : baseTint;
+    
+    /// <summary>
+    /// Takes ownership of the combined mesh and its index/ID copies, and starts drawing the components.
+    /// Ranges must be in mesh order.
+    /// </summary>
+    internal void Initialize(Mesh combinedMesh, Material material, Color? tint,
+        NativeArray<ushort> meshIndices, NativeArray<float> meshComponentIds,
+        List<BuildingComponent> components, List<Vector2Int> vertexRanges, List<Vector2Int> indexRanges)
+    {
+        mesh = combinedMesh;
+        baseMaterial = material;
+        baseTint = tint;
+        indices = meshIndices;
+        componentIds = meshComponentIds;
+        
+        GetComponent<MeshFilter>().sharedMesh = mesh;
+        meshRenderer = GetComponent<MeshRenderer>();
+        ApplyMaterial();
+        
+        for (int i = 0; i < components.Count; i++)
+        {
+            slots[components[i]] = ranges.Count;
+            ranges.Add(new ComponentRange
+            {
+                component = components[i],
+                vertexStart = vertexRanges[i].x,
+                vertexCount = vertexRanges[i].y,
+                indexStart = indexRanges[i].x,
+                indexCount = indexRanges[i].y,
+                attached = true
+            });
+        }
+        AttachedCount = components.Count;
+        
+        // Each component reattaches or detaches itself against the chunk's appearance
+        foreach (var component in components)
+        {
+            component.SetCombinedChunk(this);
+        }
+    }
+    
+    void LateUpdate()
+    {
+        // State indices are assigned in bulk at registration; upload the ID stream once per frame at most
+        if (componentIdsDirty && mesh != null)
+        {
+            mesh.SetVertexBufferData(componentIds, 0, 0, componentIds.Length, 1, PartialUpdateFlags);
+            componentIdsDirty = false;
+        }
+    }
+    
+    void OnDestroy()
+    {
+        // Hand the components back to their own renderers
+        foreach (var range in ranges)
+        {
+            if (range.component != null)
+            {
+                range.component.SetCombinedChunk(null);
+            }
+        }
+        ranges.Clear();
+        slots.Clear();
+        
+        if (indices.IsCreated) indices.Dispose();
+        if (componentIds.IsCreated) componentIds.Dispose();
+        if (mesh != null)
+        {
+            Destroy(mesh);
+        }
+    }
+    
+    /// <summary>
+    /// Component whose triangle was hit (e.g. RaycastHit.triangleIndex against this mesh), or null
+    /// </summary>
+    public BuildingComponent GetComponentAtTriangle(int triangleIndex)
+    {
+        int index = triangleIndex * 3;
+        int low = 0;
+        int high = ranges.Count - 1;
+        while (low <= high)
+        {
+            int middle = (low + high) >> 1;
+            ComponentRange range = ranges[middle];
+            if (index < range.indexStart)
+            {
+                high = middle - 1;
+            }
+            else if (index >= range.indexStart + range.indexCount)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                return range.attached ? range.component : null;
+            }
+        }
+        return null;
+    }
+    
+    /// <summary>
+    /// Whether the chunk currently draws the component
+    /// </summary>
+    public bool IsAttached(BuildingComponent component)
+    {
+        return slots.TryGetValue(component, out int slot) && ranges[slot].attached;
+    }
+    
+    /// <summary>
+    /// Draws the component if it looks like the chunk (attaching it if needed) and returns true;
+    /// otherwise detaches it and returns false so the component's own renderer draws it
+    /// </summary>
+    internal bool TryDraw(BuildingComponent component, Material material, Color? tint)
+    {
+        if (!slots.TryGetValue(component, out int slot))
+            return false;
+        
+        bool matches = material == CurrentMaterial && tint == CurrentTint;
+        SetAttached(slot, matches);
+        return matches;
+    }
+    
+    /// <summary>
+    /// Switches the whole chunk to the heatmap material, or back to its own when null
+    /// </summary>
+    internal void SetHeatmapMaterial(Material material)
+    {
+        if (heatmapMaterial == material)
+            return;
+        
+        heatmapMaterial = material;
+        ApplyMaterial();
+    }
+    
+    /// <summary>
+    /// Rewrites a component's ID stream after its state index changed
+    /// </summary>
+    internal void RefreshComponentId(BuildingComponent component)
+    {
+        if (!slots.TryGetValue(component, out int slot) || !componentIds.IsCreated)
+            return;
+        
+        ComponentRange range = ranges[slot];
+        float id = component.StateIndex + 1;
+        for (int v = range.vertexStart; v < range.vertexStart + range.vertexCount; v++)
+        {
+            componentIds[v] = id;
+        }
+        componentIdsDirty = true;
+    }
+    
+    /// <summary>
+    /// Drops a destroyed component from the chunk
+    /// </summary>
+    internal void Remove(BuildingComponent component)
+    {
+        if (!slots.TryGetValue(component, out int slot))
+            return;
+        
+        SetAttached(slot, false);
+        ComponentRange range = ranges[slot];
+        range.component = null;
+        ranges[slot] = range;
+        slots.Remove(component);
+    }
+    
+    private void SetAttached(int slot, bool attached)
+    {
+        ComponentRange range = ranges[slot];
+        if (range.attached == attached || mesh == null)
+            return;
+        
+        if (attached)
+        {
+            mesh.SetIndexBufferData(indices, range.indexStart, range.indexStart, range.indexCount, PartialUpdateFlags);
+            AttachedCount++;
+        }
+        else
+        {
+            // Every index points at the range's first vertex: zero-area triangles the GPU discards
+            using (NativeArray<ushort> degenerate = new NativeArray<ushort>(range.indexCount, Allocator.Temp))
+            {
+                ushort first = (ushort)range.vertexStart;
+                for (int i = 0; i < degenerate.Length; i++)
+                {
+                    degenerate[i] = first;
+                }
+                mesh.SetIndexBufferData(degenerate, 0, range.indexStart, range.indexCount, PartialUpdateFlags);
+            }
+            AttachedCount--;
+        }
+        
+        range.attached = attached;
+        ranges[slot] = range;
+        
+        // Nothing left to draw
+        meshRenderer.enabled = AttachedCount > 0;
+    }
+    
+    private void ApplyMaterial()
+    {
+        meshRenderer.sharedMaterial = CurrentMaterial;
+        
+        Color? tint = CurrentTint;
+        if (tint.HasValue)
+        {
+            if (propertyBlock == null)
+            {
+                propertyBlock = new MaterialPropertyBlock();
+            }
+            
+            propertyBlock.Clear();
+            propertyBlock.SetColor(BaseColorId, tint.Value);
+            propertyBlock.SetColor(ColorId, tint.Value);
+            meshRenderer.SetPropertyBlock(propertyBlock);
+        }
+        else
+        {
+            meshRenderer.SetPropertyBlock(null);
+        }
+    }
+}
\ No newline at end of file
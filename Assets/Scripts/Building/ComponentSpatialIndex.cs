@@ -0,0 +1,718 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+using Unity.Burst;
+using Unity.Collections;
+using Unity.Jobs;
+using Unity.Mathematics;
+
+/// <summary>
+/// Bounding volume hierarchy over the world bounds of static BuildingComponents, for picking and region
+/// queries without colliders. The tree is built by a Burst job (median split on the longest centroid axis)
+/// that runs in the background until the first query. Ray picks are refined against the component's mesh
+/// triangles (or its collider, if the mesh is not readable), so an element's loose bounds never hide the one
+/// in front. A mesh's triangles are copied into native buffers the first time a ray reaches it, and later
+/// picks test them with Burst on the main thread without allocating.
+/// Elements are assumed not to move; rebuild the index after moving them. Meshes are assumed not to change in
+/// place either; call InvalidateMesh after editing a mesh's vertices or indices. Main thread only.
+/// </summary>
+public class ComponentSpatialIndex : IDisposable
+{
+    private const int LeafSize = 4;
+    private const int MaxDepth = 64;
+    
+    /// <summary>
+    /// Interior nodes have count 0 and their children at start and start + 1;
+    /// leaves hold order[start .. start + count)
+    /// </summary>
+    private struct Node
+    {
+        public float3 min;
+        public int start;
+        public float3 max;
+        public int count;
+    }
+    
+    /// <summary>
+    /// A mesh's triangles in the cached geometry: positions from vertexStart, mesh-relative indices from indexStart
+    /// </summary>
+    private struct MeshRange
+    {
+        public int vertexStart;
+        public int indexStart;
+        public int indexCount;
+    }
+    
+    private interface IOverlapTest
+    {
+        bool Overlaps(float3 min, float3 max);
+    }
+    
+    private struct BoxOverlap : IOverlapTest
+    {
+        public float3 min;
+        public float3 max;
+        
+        public bool Overlaps(float3 nodeMin, float3 nodeMax) => math.all(nodeMin <= max & nodeMax >= min);
+    }
+    
+    private struct SphereOverlap : IOverlapTest
+    {
+        public float3 center;
+        public float radiusSquared;
+        
+        public bool Overlaps(float3 nodeMin, float3 nodeMax) => math.distancesq(math.clamp(center, nodeMin, nodeMax), center) <= radiusSquared;
+    }
+    
+    private readonly List<BuildingComponent> components = new List<BuildingComponent>();
+    private readonly Dictionary<string, List<int>> itemsBySpace = new Dictionary<string, List<int>>(StringComparer.Ordinal);
+    private readonly Dictionary<string, int> itemsByGlobalId = new Dictionary<string, int>(StringComparer.Ordinal);
+    private readonly IReadOnlyDictionary<string, BuildingOrganizer.SpaceData> spaces;
+    
+    private NativeArray<float3> boundsMin;
+    private NativeArray<float3> boundsMax;
+    private NativeArray<int> order;
+    private NativeArray<Node> nodes;
+    private NativeArray<int> nodeCount;
+    private JobHandle buildHandle;
+    private bool building;
+    
+    // Query scratch
+    private readonly int[] stack = new int[MaxDepth * 2];
+    private readonly List<(int item, float distance)> candidates = new List<(int item, float distance)>();
+    private readonly List<int> candidateItems = new List<int>();
+    private NativeArray<MeshRange> candidateRanges;
+    private NativeArray<float3> rayOrigins;
+    private NativeArray<float3> rayDirections;
+    private NativeArray<float> rayHits;
+    
+    // Triangles of the meshes rays have reached, by mesh instance ID (copied once; see InvalidateMesh)
+    private readonly Dictionary<int, MeshRange> meshRanges = new Dictionary<int, MeshRange>();
+    private NativeArray<float3> cachedPositions;
+    private NativeArray<int> cachedIndices;
+    private int cachedVertexCount;
+    private int cachedIndexCount;
+    private readonly List<Vector3> meshVertices = new List<Vector3>();
+    private readonly List<int> meshIndices = new List<int>();
+    
+    public int Count => components.Count;
+    public bool IsCreated => nodes.IsCreated;
+    
+    /// <summary>
+    /// Collects component bounds and schedules the build; spaces (optional) add boundary elements to space queries
+    /// </summary>
+    public ComponentSpatialIndex(IEnumerable<BuildingComponent> source, IReadOnlyDictionary<string, BuildingOrganizer.SpaceData> spaces = null)
+    {
+        this.spaces = spaces;
+        
+        List<Bounds> bounds = new List<Bounds>();
+        foreach (var component in source)
+        {
+            if (component == null || !TryGetWorldBounds(component, out Bounds componentBounds))
+                continue;
+            
+            int item = components.Count;
+            components.Add(component);
+            bounds.Add(componentBounds);
+            
+            if (!string.IsNullOrEmpty(component.globalId))
+            {
+                itemsByGlobalId[component.globalId] = item;
+            }
+            if (!string.IsNullOrEmpty(component.spaceId))
+            {
+                if (!itemsBySpace.TryGetValue(component.spaceId, out List<int> members))
+                {
+                    members = new List<int>();
+                    itemsBySpace.Add(component.spaceId, members);
+                }
+                members.Add(item);
+            }
+        }
+        
+        int count = components.Count;
+        boundsMin = new NativeArray<float3>(count, Allocator.Persistent);
+        boundsMax = new NativeArray<float3>(count, Allocator.Persistent);
+        for (int i = 0; i < count; i++)
+        {
+            boundsMin[i] = bounds[i].min;
+            boundsMax[i] = bounds[i].max;
+        }
+        
+        order = new NativeArray<int>(count, Allocator.Persistent);
+        nodes = new NativeArray<Node>(Math.Max(2 * count - 1, 1), Allocator.Persistent);
+        nodeCount = new NativeArray<int>(1, Allocator.Persistent);
+        
+        buildHandle = new BuildJob
+        {
+            boundsMin = boundsMin,
+            boundsMax = boundsMax,
+            order = order,
+            nodes = nodes,
+            nodeCount = nodeCount
+        }.Schedule();
+        building = true;
+    }
+    
+    /// <summary>
+    /// Closest component whose geometry the ray hits within maxDistance
+    /// </summary>
+    public bool Raycast(Ray ray, float maxDistance, out BuildingComponent component, out float distance)
+    {
+        component = null;
+        distance = maxDistance;
+        
+        CompleteBuild();
+        if (nodeCount[0] == 0)
+            return false;
+        
+        // Broad phase: every component whose bounds the ray enters, nearest first
+        float3 origin = ray.origin;
+        float3 direction = ray.direction;
+        // Axis-parallel rays: a tiny component instead of zero keeps the slab test free of 0 * inf
+        float3 inverseDirection = 1f / math.select(direction, new float3(1e-20f), direction == 0f);
+        
+        candidates.Clear();
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            Node node = nodes[stack[--top]];
+            if (!IntersectRay(origin, inverseDirection, node.min, node.max, maxDistance, out _))
+                continue;
+            
+            if (node.count == 0)
+            {
+                stack[top++] = node.start;
+                stack[top++] = node.start + 1;
+                continue;
+            }
+            
+            for (int i = node.start; i < node.start + node.count; i++)
+            {
+                int item = order[i];
+                if (IntersectRay(origin, inverseDirection, boundsMin[item], boundsMax[item], maxDistance, out float entry))
+                {
+                    candidates.Add((item, entry));
+                }
+            }
+        }
+        
+        if (candidates.Count == 0)
+            return false;
+        
+        candidates.Sort((a, b) => a.distance.CompareTo(b.distance));
+        
+        // Narrow phase: readable meshes by their cached triangles (what is drawn, even if a collider is
+        // simpler), colliders for the rest, anything else by its bounds
+        int best = -1;
+        candidateItems.Clear();
+        foreach (var (item, entry) in candidates)
+        {
+            BuildingComponent candidate = components[item];
+            if (candidate == null || entry >= distance)
+                continue;
+            
+            MeshFilter meshFilter = candidate.GetComponent<MeshFilter>();
+            if (meshFilter != null && meshFilter.sharedMesh != null && meshFilter.sharedMesh.isReadable)
+            {
+                EnsureCapacity(ref candidateRanges, candidateItems.Count + 1);
+                candidateRanges[candidateItems.Count] = GetMeshRange(meshFilter.sharedMesh);
+                candidateItems.Add(item);
+                continue;
+            }
+            
+            Collider collider = candidate.GetComponent<Collider>();
+            if (collider != null && collider.enabled)
+            {
+                if (collider.Raycast(ray, out RaycastHit hit, distance))
+                {
+                    best = item;
+                    distance = hit.distance;
+                }
+                continue;
+            }
+            
+            best = item;
+            distance = entry;
+        }
+        
+        if (candidateItems.Count > 0)
+        {
+            RaycastMeshes(ray, ref best, ref distance);
+        }
+        
+        if (best < 0)
+        {
+            distance = maxDistance;
+            return false;
+        }
+        
+        component = components[best];
+        return true;
+    }
+    
+    /// <summary>
+    /// Adds the components whose bounds overlap the box to results
+    /// </summary>
+    public int QueryBox(Bounds box, List<BuildingComponent> results)
+    {
+        return Query(results, new BoxOverlap { min = box.min, max = box.max });
+    }
+    
+    /// <summary>
+    /// Adds the components whose bounds come within radius of center to results
+    /// </summary>
+    public int QuerySphere(Vector3 center, float radius, List<BuildingComponent> results)
+    {
+        return Query(results, new SphereOverlap { center = center, radiusSquared = radius * radius });
+    }
+    
+    /// <summary>
+    /// Adds the components contained in a space to results, plus its boundary elements (walls, slabs,
+    /// windows) if requested and the index was built with the building's spaces
+    /// </summary>
+    public int QuerySpace(string spaceId, List<BuildingComponent> results, bool includeBoundaries = true)
+    {
+        if (string.IsNullOrEmpty(spaceId))
+            return 0;
+        
+        int added = 0;
+        if (itemsBySpace.TryGetValue(spaceId, out List<int> members))
+        {
+            foreach (int item in members)
+            {
+                if (components[item] != null)
+                {
+                    results.Add(components[item]);
+                    added++;
+                }
+            }
+        }
+        
+        if (includeBoundaries && spaces != null && spaces.TryGetValue(spaceId, out BuildingOrganizer.SpaceData space))
+        {
+            foreach (var boundary in space.boundaries)
+            {
+                if (boundary.element_id != null && itemsByGlobalId.TryGetValue(boundary.element_id, out int item) &&
+                    components[item] != null && components[item].spaceId != spaceId)
+                {
+                    results.Add(components[item]);
+                    added++;
+                }
+            }
+        }
+        return added;
+    }
+    
+    public void Dispose()
+    {
+        buildHandle.Complete();
+        building = false;
+        
+        if (boundsMin.IsCreated) boundsMin.Dispose();
+        if (boundsMax.IsCreated) boundsMax.Dispose();
+        if (order.IsCreated) order.Dispose();
+        if (nodes.IsCreated) nodes.Dispose();
+        if (nodeCount.IsCreated) nodeCount.Dispose();
+        if (candidateRanges.IsCreated) candidateRanges.Dispose();
+        if (rayOrigins.IsCreated) rayOrigins.Dispose();
+        if (rayDirections.IsCreated) rayDirections.Dispose();
+        if (rayHits.IsCreated) rayHits.Dispose();
+        if (cachedPositions.IsCreated) cachedPositions.Dispose();
+        if (cachedIndices.IsCreated) cachedIndices.Dispose();
+        ClearMeshCache();
+        components.Clear();
+    }
+    
+    /// <summary>
+    /// Drops a mesh's cached triangles after it was edited in place, so the next ray reaching it copies them again.
+    /// The old copy's space is only reclaimed by ClearMeshCache.
+    /// </summary>
+    public void InvalidateMesh(Mesh mesh)
+    {
+        if (mesh != null)
+        {
+            meshRanges.Remove(mesh.GetInstanceID());
+        }
+    }
+    
+    /// <summary>
+    /// Drops all cached triangles; the buffers are kept and refilled as rays reach meshes again
+    /// </summary>
+    public void ClearMeshCache()
+    {
+        meshRanges.Clear();
+        cachedVertexCount = 0;
+        cachedIndexCount = 0;
+    }
+    
+    /// <summary>
+    /// World bounds of a component's mesh, falling back to its collider or renderer.
+    /// Mesh bounds are used first since renderers drawn by a CombinedMeshChunk are disabled.
+    /// </summary>
+    public static bool TryGetWorldBounds(BuildingComponent component, out Bounds bounds)
+    {
+        MeshFilter meshFilter = component.GetComponent<MeshFilter>();
+        if (meshFilter != null && meshFilter.sharedMesh != null)
+        {
+            Bounds local = meshFilter.sharedMesh.bounds;
+            Matrix4x4 matrix = component.transform.localToWorldMatrix;
+            
+            // Extents of the transformed box: |M| * extents
+            Vector3 extents = local.extents;
+            Vector3 worldExtents = new Vector3(
+                Mathf.Abs(matrix.m00) * extents.x + Mathf.Abs(matrix.m01) * extents.y + Mathf.Abs(matrix.m02) * extents.z,
+                Mathf.Abs(matrix.m10) * extents.x + Mathf.Abs(matrix.m11) * extents.y + Mathf.Abs(matrix.m12) * extents.z,
+                Mathf.Abs(matrix.m20) * extents.x + Mathf.Abs(matrix.m21) * extents.y + Mathf.Abs(matrix.m22) * extents.z);
+            bounds = new Bounds(matrix.MultiplyPoint3x4(local.center), worldExtents * 2f);
+            return true;
+        }
+        
+        Collider collider = component.GetComponent<Collider>();
+        if (collider != null && collider.enabled)
+        {
+            bounds = collider.bounds;
+            return true;
+        }
+        
+        Renderer renderer = component.GetComponent<Renderer>();
+        if (renderer != null && renderer.enabled)
+        {
+            bounds = renderer.bounds;
+            return true;
+        }
+        
+        bounds = default;
+        return false;
+    }
+    
+    private void CompleteBuild()
+    {
+        if (building)
+        {
+            buildHandle.Complete();
+            building = false;
+        }
+    }
+    
+    private int Query<T>(List<BuildingComponent> results, T test) where T : struct, IOverlapTest
+    {
+        CompleteBuild();
+        if (nodeCount[0] == 0)
+            return 0;
+        
+        int added = 0;
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            Node node = nodes[stack[--top]];
+            if (!test.Overlaps(node.min, node.max))
+                continue;
+            
+            if (node.count == 0)
+            {
+                stack[top++] = node.start;
+                stack[top++] = node.start + 1;
+                continue;
+            }
+            
+            for (int i = node.start; i < node.start + node.count; i++)
+            {
+                int item = order[i];
+                if (components[item] != null && test.Overlaps(boundsMin[item], boundsMax[item]))
+                {
+                    results.Add(components[item]);
+                    added++;
+                }
+            }
+        }
+        return added;
+    }
+    
+    private void RaycastMeshes(Ray ray, ref int best, ref float distance)
+    {
+        int count = candidateItems.Count;
+        EnsureCapacity(ref rayOrigins, count);
+        EnsureCapacity(ref rayDirections, count);
+        EnsureCapacity(ref rayHits, count);
+        
+        // The ray in each mesh's space; t is unchanged by the transform, so it stays a world distance
+        for (int i = 0; i < count; i++)
+        {
+            Matrix4x4 worldToLocal = components[candidateItems[i]].transform.worldToLocalMatrix;
+            rayOrigins[i] = worldToLocal.MultiplyPoint3x4(ray.origin);
+            rayDirections[i] = worldToLocal.MultiplyVector(ray.direction);
+        }
+        
+        // A handful of meshes per pick: run in place rather than paying for a worker round trip
+        new RayMeshJob
+        {
+            positions = cachedPositions,
+            indices = cachedIndices,
+            ranges = candidateRanges,
+            origins = rayOrigins,
+            directions = rayDirections,
+            maxDistance = distance,
+            hits = rayHits
+        }.Run(count);
+        
+        for (int i = 0; i < count; i++)
+        {
+            if (rayHits[i] < distance)
+            {
+                distance = rayHits[i];
+                best = candidateItems[i];
+            }
+        }
+    }
+    
+    /// <summary>
+    /// The mesh's triangles in the cached geometry, copied there on first use
+    /// </summary>
+    private MeshRange GetMeshRange(Mesh mesh)
+    {
+        int id = mesh.GetInstanceID();
+        if (meshRanges.TryGetValue(id, out MeshRange range))
+            return range;
+        
+        mesh.GetVertices(meshVertices);
+        range = new MeshRange { vertexStart = cachedVertexCount, indexStart = cachedIndexCount };
+        
+        EnsureCapacity(ref cachedPositions, cachedVertexCount + meshVertices.Count);
+        for (int i = 0; i < meshVertices.Count; i++)
+        {
+            cachedPositions[cachedVertexCount++] = meshVertices[i];
+        }
+        
+        int indexCount = 0;
+        for (int s = 0; s < mesh.subMeshCount; s++)
+        {
+            if (mesh.GetTopology(s) == MeshTopology.Triangles)
+            {
+                indexCount += (int)mesh.GetIndexCount(s);
+            }
+        }
+        EnsureCapacity(ref cachedIndices, cachedIndexCount + indexCount);
+        
+        for (int s = 0; s < mesh.subMeshCount; s++)
+        {
+            if (mesh.GetTopology(s) != MeshTopology.Triangles)
+                continue;
+            
+            mesh.GetIndices(meshIndices, s);
+            for (int i = 0; i < meshIndices.Count; i++)
+            {
+                cachedIndices[cachedIndexCount++] = meshIndices[i];
+            }
+        }
+        
+        range.indexCount = cachedIndexCount - range.indexStart;
+        meshRanges.Add(id, range);
+        return range;
+    }
+    
+    /// <summary>
+    /// Grows a persistent array to hold at least capacity elements, keeping its contents
+    /// </summary>
+    private static void EnsureCapacity<T>(ref NativeArray<T> array, int capacity) where T : struct
+    {
+        if (array.IsCreated && array.Length >= capacity)
+            return;
+        
+        NativeArray<T> grown = new NativeArray<T>(Math.Max(capacity, array.IsCreated ? array.Length * 2 : 16), Allocator.Persistent);
+        if (array.IsCreated)
+        {
+            NativeArray<T>.Copy(array, grown, array.Length);
+            array.Dispose();
+        }
+        array = grown;
+    }
+    
+    private static bool IntersectRay(float3 origin, float3 inverseDirection, float3 min, float3 max, float maxDistance, out float entry)
+    {
+        float3 t0 = (min - origin) * inverseDirection;
+        float3 t1 = (max - origin) * inverseDirection;
+        float3 near = math.min(t0, t1);
+        float3 far = math.max(t0, t1);
+        entry = math.max(math.cmax(near), 0f);
+        float exit = math.min(math.cmin(far), maxDistance);
+        return entry <= exit;
+    }
+    
+    /// <summary>
+    /// Top-down build: each node's items are split at the median centroid along the node's longest
+    /// centroid axis (quickselect, no full sort), until a node holds LeafSize items or fewer
+    /// </summary>
+    [BurstCompile]
+    private struct BuildJob : IJob
+    {
+        [ReadOnly] public NativeArray<float3> boundsMin;
+        [ReadOnly] public NativeArray<float3> boundsMax;
+        public NativeArray<int> order;
+        public NativeArray<Node> nodes;
+        public NativeArray<int> nodeCount;
+        
+        public void Execute()
+        {
+            int count = order.Length;
+            if (count == 0)
+            {
+                nodeCount[0] = 0;
+                return;
+            }
+            
+            NativeArray<float3> centroids = new NativeArray<float3>(count, Allocator.Temp);
+            for (int i = 0; i < count; i++)
+            {
+                order[i] = i;
+                centroids[i] = (boundsMin[i] + boundsMax[i]) * 0.5f;
+            }
+            
+            // (node, start, count) triples
+            NativeArray<int> pending = new NativeArray<int>(MaxDepth * 2 * 3, Allocator.Temp);
+            int top = 0;
+            int used = 1;
+            pending[top++] = 0;
+            pending[top++] = 0;
+            pending[top++] = count;
+            
+            while (top > 0)
+            {
+                int itemCount = pending[--top];
+                int start = pending[--top];
+                int node = pending[--top];
+                
+                float3 min = new float3(float.MaxValue);
+                float3 max = new float3(float.MinValue);
+                float3 centroidMin = new float3(float.MaxValue);
+                float3 centroidMax = new float3(float.MinValue);
+                for (int i = start; i < start + itemCount; i++)
+                {
+                    int item = order[i];
+                    min = math.min(min, boundsMin[item]);
+                    max = math.max(max, boundsMax[item]);
+                    centroidMin = math.min(centroidMin, centroids[item]);
+                    centroidMax = math.max(centroidMax, centroids[item]);
+                }
+                
+                float3 extent = centroidMax - centroidMin;
+                int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+                
+                // Small enough, coincident centroids, or out of stack: make a leaf
+                if (itemCount <= LeafSize || extent[axis] <= 0f || top + 6 > pending.Length)
+                {
+                    nodes[node] = new Node { min = min, max = max, start = start, count = itemCount };
+                    continue;
+                }
+                
+                int middle = start + itemCount / 2;
+                Select(centroids, start, start + itemCount - 1, middle, axis);
+                
+                int left = used;
+                used += 2;
+                nodes[node] = new Node { min = min, max = max, start = left, count = 0 };
+                
+                pending[top++] = left;
+                pending[top++] = start;
+                pending[top++] = middle - start;
+                pending[top++] = left + 1;
+                pending[top++] = middle;
+                pending[top++] = start + itemCount - middle;
+            }
+            
+            nodeCount[0] = used;
+            pending.Dispose();
+            centroids.Dispose();
+        }
+        
+        /// <summary>
+        /// Reorders order[left..right] so that order[k] holds the k-th smallest centroid on the axis
+        /// </summary>
+        private void Select(NativeArray<float3> centroids, int left, int right, int k, int axis)
+        {
+            while (right > left)
+            {
+                float pivot = centroids[order[(left + right) >> 1]][axis];
+                int i = left;
+                int j = right;
+                while (i <= j)
+                {
+                    while (centroids[order[i]][axis] < pivot) i++;
+                    while (centroids[order[j]][axis] > pivot) j--;
+                    if (i <= j)
+                    {
+                        int swap = order[i];
+                        order[i] = order[j];
+                        order[j] = swap;
+                        i++;
+                        j--;
+                    }
+                }
+                
+                if (k <= j)
+                    right = j;
+                else if (k >= i)
+                    left = i;
+                else
+                    return;
+            }
+        }
+    }
+    
+    /// <summary>
+    /// Nearest double-sided triangle hit per mesh (Möller–Trumbore); float.MaxValue if none within maxDistance
+    /// </summary>
+    [BurstCompile]
+    private struct RayMeshJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<float3> positions;
+        [ReadOnly] public NativeArray<int> indices;
+        [ReadOnly] public NativeArray<MeshRange> ranges;
+        [ReadOnly] public NativeArray<float3> origins;
+        [ReadOnly] public NativeArray<float3> directions;
+        public float maxDistance;
+        public NativeArray<float> hits;
+        
+        public void Execute(int index)
+        {
+            MeshRange range = ranges[index];
+            float3 origin = origins[index];
+            float3 direction = directions[index];
+            float nearest = float.MaxValue;
+            
+            int end = range.indexStart + range.indexCount;
+            for (int i = range.indexStart; i + 2 < end; i += 3)
+            {
+                float3 v0 = positions[range.vertexStart + indices[i]];
+                float3 edge1 = positions[range.vertexStart + indices[i + 1]] - v0;
+                float3 edge2 = positions[range.vertexStart + indices[i + 2]] - v0;
+            
+                float3 p = math.cross(direction, edge2);
+                float determinant = math.dot(edge1, p);
+                if (math.abs(determinant) < 1e-12f)
+                    continue;
+                
+                float inverse = 1f / determinant;
+                float3 toOrigin = origin - v0;
+                float u = math.dot(toOrigin, p) * inverse;
+                if (u < 0f || u > 1f)
+                    continue;
+                
+                float3 q = math.cross(toOrigin, edge1);
+                float v = math.dot(direction, q) * inverse;
+                if (v < 0f || u + v > 1f)
+                    continue;
+                
+                float t = math.dot(edge2, q) * inverse;
+                if (t >= 0f && t < nearest && t <= maxDistance)
+                {
+                    nearest = t;
+                }
+            }
+            
+            hits[index] = nearest;
+        }
+    }
+}
\ No newline at end of file
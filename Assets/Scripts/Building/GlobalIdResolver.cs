@@ -0,0 +1,167 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+using System.Linq.Expressions;
+using System.Reflection;
+
+/// <summary>
+/// Resolves IFC GlobalIds for scene objects produced by IFC importers.
+/// A "GlobalId" property or field is looked up once per MonoBehaviour type and cached as a compiled delegate,
+/// so scanning large scenes does not hit reflection per object. Main thread only.
+/// </summary>
+public static class GlobalIdResolver
+{
+    // IFC GlobalIds are 22 characters of a base64 variant (0-9, A-Z, a-z, _ and $)
+    public const int IfcGlobalIdLength = 22;
+    
+    private const string GlobalIdMemberName = "GlobalId";
+    
+    // Per-type accessor cache; a null entry means the type has no usable GlobalId member
+    private static readonly Dictionary<Type, Func<MonoBehaviour, string>> accessorCache = new Dictionary<Type, Func<MonoBehaviour, string>>();
+    
+    // Reused component buffer to avoid allocating an array per GetComponents call
+    private static readonly List<MonoBehaviour> behaviourBuffer = new List<MonoBehaviour>();
+    
+    /// <summary>
+    /// Returns the GlobalId of an object, checking every MonoBehaviour on it before falling back to its name
+    /// </summary>
+    public static string Resolve(GameObject obj)
+    {
+        // Method 1: GlobalId property or field on any attached MonoBehaviour
+        obj.GetComponents(behaviourBuffer);
+        try
+        {
+            for (int i = 0; i < behaviourBuffer.Count; i++)
+            {
+                MonoBehaviour behaviour = behaviourBuffer[i];
+                if (behaviour == null)
+                    continue; // Missing script
+                
+                Func<MonoBehaviour, string> accessor = GetAccessor(behaviour.GetType());
+                if (accessor == null)
+                    continue;
+                
+                string id = accessor(behaviour);
+                if (!string.IsNullOrEmpty(id))
+                {
+                    return id;
+                }
+            }
+        }
+        finally
+        {
+            behaviourBuffer.Clear();
+        }
+        
+        // Methods 2 and 3: name patterns
+        return ParseFromName(obj.name);
+    }
+    
+    /// <summary>
+    /// Extracts a GlobalId from an object name of the form "ElementName [GlobalId]" or "GlobalId_Name".
+    /// Only the returned id is allocated; non-matching names cost no allocations.
+    /// </summary>
+    public static string ParseFromName(string name)
+    {
+        if (string.IsNullOrEmpty(name))
+            return null;
+        
+        // "ElementName [GlobalId]"
+        int startBracket = name.IndexOf('[');
+        if (startBracket >= 0)
+        {
+            int endBracket = name.IndexOf(']', startBracket + 1);
+            if (endBracket > startBracket + 1)
+            {
+                return name.Substring(startBracket + 1, endBracket - startBracket - 1);
+            }
+        }
+        
+        // "GlobalId_Name", where the prefix must look like a 22-character IFC GlobalId
+        int underscore = name.IndexOf('_');
+        if (underscore == IfcGlobalIdLength && underscore < name.Length - 1 && IsGlobalIdPrefix(name))
+        {
+            return name.Substring(0, IfcGlobalIdLength);
+        }
+        
+        return null;
+    }
+    
+    /// <summary>
+    /// Drops all cached accessors (e.g. after a domain reload with new importer types)
+    /// </summary>
+    public static void ClearCache()
+    {
+        accessorCache.Clear();
+    }
+    
+    private static bool IsGlobalIdPrefix(string name)
+    {
+        for (int i = 0; i < IfcGlobalIdLength; i++)
+        {
+            char c = name[i];
+            bool valid = (c >= '0' && c <= '9') ||
+                         (c >= 'A' && c <= 'Z') ||
+                         (c >= 'a' && c <= 'z') ||
+                         c == '_' || c == '$';
+            if (!valid)
+                return false;
+        }
+        return true;
+    }
+    
+    private static Func<MonoBehaviour, string> GetAccessor(Type type)
+    {
+        if (!accessorCache.TryGetValue(type, out Func<MonoBehaviour, string> accessor))
+        {
+            accessor = CreateAccessor(type);
+            accessorCache[type] = accessor;
+        }
+        return accessor;
+    }
+    
+    /// <summary>
+    /// Builds a delegate reading the public GlobalId property or field of a type, or null if it has none
+    /// </summary>
+    private static Func<MonoBehaviour, string> CreateAccessor(Type type)
+    {
+        PropertyInfo property = type.GetProperty(GlobalIdMemberName, BindingFlags.Public | BindingFlags.Instance);
+        if (property != null && (!property.CanRead || property.GetIndexParameters().Length > 0))
+        {
+            property = null;
+        }
+        
+        FieldInfo field = property == null ? type.GetField(GlobalIdMemberName, BindingFlags.Public | BindingFlags.Instance) : null;
+        
+        Type memberType = property != null ? property.PropertyType : field?.FieldType;
+        
+        // Only string-compatible members can hold an id (non-string values never matched before either)
+        if (memberType == null || !memberType.IsAssignableFrom(typeof(string)))
+            return null;
+        
+        try
+        {
+            ParameterExpression target = Expression.Parameter(typeof(MonoBehaviour), "target");
+            Expression typedTarget = Expression.Convert(target, type);
+            Expression value = property != null
+                ? Expression.Property(typedTarget, property)
+                : Expression.Field(typedTarget, field);
+            
+            if (memberType != typeof(string))
+            {
+                value = Expression.TypeAs(value, typeof(string));
+            }
+            
+            return Expression.Lambda<Func<MonoBehaviour, string>>(value, target).Compile();
+        }
+        catch (Exception)
+        {
+            // Platforms without dynamic code generation: fall back to a cached reflection accessor
+            if (property != null)
+            {
+                return behaviour => property.GetValue(behaviour) as string;
+            }
+            return behaviour => field.GetValue(behaviour) as string;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+using System;
+using System.Collections.Generic;
+
+/// <summary>
+/// Broad element classes used to pick default materials and colliders for IFC types
+/// </summary>
+public enum IfcElementKind
+{
+    Unknown,
+    Wall,
+    Window,
+    FloorSlab,
+    RoofSlab,
+    Slab,
+    Door,
+    Column,
+    Beam,
+    Roof,
+    Stair,
+    Railing,
+    Furnishing
+}
+
+/// <summary>
+/// Maps IFC type strings (e.g. "IfcWallStandardCase") to an IfcElementKind.
+/// Each distinct type string is classified once and cached. Main thread only.
+/// </summary>
+public static class IfcElementClassifier
+{
+    private static readonly Dictionary<string, IfcElementKind> cache = new Dictionary<string, IfcElementKind>(StringComparer.Ordinal);
+    
+    /// <summary>
+    /// Returns the element kind for an IFC type string
+    /// </summary>
+    public static IfcElementKind Classify(string ifcType)
+    {
+        if (string.IsNullOrEmpty(ifcType))
+            return IfcElementKind.Unknown;
+        
+        if (!cache.TryGetValue(ifcType, out IfcElementKind kind))
+        {
+            kind = ClassifyUncached(ifcType);
+            cache.Add(ifcType, kind);
+        }
+        return kind;
+    }
+    
+    /// <summary>
+    /// True for slabs of any kind
+    /// </summary>
+    public static bool IsSlab(IfcElementKind kind)
+    {
+        return kind == IfcElementKind.Slab || kind == IfcElementKind.FloorSlab || kind == IfcElementKind.RoofSlab;
+    }
+    
+    private static IfcElementKind ClassifyUncached(string ifcType)
+    {
+        // Checked in priority order, matching substrings case-insensitively
+        if (Contains(ifcType, "ifcwall"))
+            return IfcElementKind.Wall;
+        if (Contains(ifcType, "ifcwindow"))
+            return IfcElementKind.Window;
+        if (Contains(ifcType, "ifcslab"))
+        {
+            if (Contains(ifcType, "floor"))
+                return IfcElementKind.FloorSlab;
+            if (Contains(ifcType, "roof"))
+                return IfcElementKind.RoofSlab;
+            return IfcElementKind.Slab;
+        }
+        if (Contains(ifcType, "ifcdoor"))
+            return IfcElementKind.Door;
+        if (Contains(ifcType, "ifccolumn"))
+            return IfcElementKind.Column;
+        if (Contains(ifcType, "ifcbeam"))
+            return IfcElementKind.Beam;
+        if (Contains(ifcType, "ifcroof"))
+            return IfcElementKind.Roof;
+        if (Contains(ifcType, "ifcstair"))
+            return IfcElementKind.Stair;
+        if (Contains(ifcType, "ifcrailing"))
+            return IfcElementKind.Railing;
+        if (Contains(ifcType, "ifcfurnishingelement"))
+            return IfcElementKind.Furnishing;
+        
+        return IfcElementKind.Unknown;
+    }
+    
+    private static bool Contains(string value, string token)
+    {
+        return value.IndexOf(token, StringComparison.OrdinalIgnoreCase) >= 0;
+    }
+}
\ No newline at end of file
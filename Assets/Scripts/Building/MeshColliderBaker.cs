@@ -0,0 +1,287 @@
+using UnityEngine;
+using System.Collections.Generic;
+using System.Diagnostics;
+using Unity.Collections;
+using Unity.Jobs;
+
+/// <summary>
+/// Moves MeshCollider cooking off the main thread. Queued elements' meshes are deduplicated and cooked
+/// with Physics.BakeMesh in a parallel job; a collider is only added once its mesh is cooked, so adding it
+/// hits PhysX's cooked-mesh cache instead of cooking. Colliders are attached within a per-frame budget,
+/// and only for the storeys around the player: elements on other storeys get theirs when the player
+/// arrives. Elements without a storey are attached as soon as they are cooked.
+/// </summary>
+public class MeshColliderBaker : MonoBehaviour
+{
+    [Header("Attachment")]
+    [Tooltip("Player or camera whose height selects the storeys that get colliders; main camera if empty")]
+    public Transform player;
+    [Tooltip("Storeys above and below the player's that also get colliders (e.g. for stairs)")]
+    public int storeyMargin = 1;
+    [Tooltip("Attach colliders on every storey instead of only around the player")]
+    public bool attachAllStoreys = false;
+    [Tooltip("Main-thread milliseconds per frame spent adding colliders")]
+    [Range(0.1f, 10f)]
+    public float frameBudgetMilliseconds = 1.0f;
+    
+    [Header("References")]
+    public BuildingOrganizer organizer;
+    
+    private struct PendingCollider
+    {
+        public GameObject target;
+        public Mesh mesh;
+    }
+    
+    /// <summary>
+    /// Cooks each mesh for a non-convex MeshCollider with the collider's default cooking options
+    /// </summary>
+    private struct BakeJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<int> meshIds;
+        
+        public void Execute(int index)
+        {
+            Physics.BakeMesh(meshIds[index], false);
+        }
+    }
+    
+    // Pending elements by storey GlobalId ("" for none)
+    private readonly Dictionary<string, List<PendingCollider>> pendingByStorey = new Dictionary<string, List<PendingCollider>>();
+    private int pendingCount = 0;
+    
+    // Unique meshes: queued for the next job, in the running job, or cooked
+    private readonly HashSet<Mesh> knownMeshes = new HashSet<Mesh>();
+    private readonly HashSet<Mesh> bakedMeshes = new HashSet<Mesh>();
+    private readonly List<Mesh> meshesToBake = new List<Mesh>();
+    private readonly List<Mesh> bakingMeshes = new List<Mesh>();
+    private NativeArray<int> bakingIds;
+    private JobHandle bakeHandle;
+    private bool baking = false;
+    
+    // Storeys bottom to top, and the window of active ones around the player
+    private readonly List<string> storeysByElevation = new List<string>();
+    private readonly List<float> storeyElevations = new List<float>();
+    private readonly HashSet<string> activeStoreys = new HashSet<string>();
+    private int storeyCount = -1;
+    private int playerStorey = -1;
+    private readonly Stopwatch frameTimer = new Stopwatch();
+    
+    public int PendingCount => pendingCount;
+    public int BakedMeshCount => bakedMeshes.Count;
+    public bool IsBaking => baking || meshesToBake.Count > 0;
+    
+    /// <summary>
+    /// Queues a MeshCollider for an element. Returns false if the mesh cannot be cooked off the main
+    /// thread (not readable), in which case the caller should add the collider itself.
+    /// </summary>
+    public bool Enqueue(GameObject target, Mesh mesh, string storeyId)
+    {
+        if (target == null || mesh == null || !mesh.isReadable)
+            return false;
+        
+        string key = storeyId ?? string.Empty;
+        if (!pendingByStorey.TryGetValue(key, out List<PendingCollider> pending))
+        {
+            pending = new List<PendingCollider>();
+            pendingByStorey.Add(key, pending);
+        }
+        pending.Add(new PendingCollider { target = target, mesh = mesh });
+        pendingCount++;
+        
+        if (knownMeshes.Add(mesh))
+        {
+            meshesToBake.Add(mesh);
+        }
+        return true;
+    }
+    
+    /// <summary>
+    /// Waits for cooking and attaches every pending collider now, regardless of storey or budget
+    /// </summary>
+    public void AttachAll()
+    {
+        CompleteBake();
+        StartBake();
+        CompleteBake();
+        
+        foreach (var pending in pendingByStorey.Values)
+        {
+            Attach(pending, float.PositiveInfinity);
+        }
+    }
+    
+    void Start()
+    {
+        if (organizer == null)
+        {
+            organizer = GetComponent<BuildingOrganizer>();
+        }
+    }
+    
+    void Update()
+    {
+        if (baking && bakeHandle.IsCompleted)
+        {
+            CompleteBake();
+        }
+        
+        // Meshes queued during the import are cooked while it carries on
+        if (!baking && meshesToBake.Count > 0)
+        {
+            StartBake();
+        }
+        
+        // Until the storeys are known every element would look storey-less; keep cooking, attach later
+        if (pendingCount == 0 || (organizer != null && organizer.IsImporting && !organizer.SpatialStructureReady))
+            return;
+        
+        bool everyStorey = attachAllStoreys || !UpdateActiveStoreys();
+        
+        frameTimer.Restart();
+        foreach (var entry in pendingByStorey)
+        {
+            if (frameTimer.Elapsed.TotalMilliseconds >= frameBudgetMilliseconds)
+                break;
+            
+            // Elements without a known storey cannot be deferred by storey
+            if (everyStorey || entry.Key.Length == 0 || activeStoreys.Contains(entry.Key) || !organizer.Storeys.ContainsKey(entry.Key))
+            {
+                Attach(entry.Value, frameBudgetMilliseconds);
+            }
+        }
+    }
+    
+    void OnDestroy()
+    {
+        // The job only reads mesh ids, but the id array must outlive it
+        bakeHandle.Complete();
+        if (bakingIds.IsCreated)
+        {
+            bakingIds.Dispose();
+        }
+    }
+    
+    private void StartBake()
+    {
+        if (baking || meshesToBake.Count == 0)
+            return;
+        
+        bakingMeshes.Clear();
+        bakingIds = new NativeArray<int>(meshesToBake.Count, Allocator.Persistent);
+        for (int i = 0; i < meshesToBake.Count; i++)
+        {
+            bakingMeshes.Add(meshesToBake[i]);
+            bakingIds[i] = meshesToBake[i].GetInstanceID();
+        }
+        meshesToBake.Clear();
+        
+        bakeHandle = new BakeJob { meshIds = bakingIds }.Schedule(bakingIds.Length, 1);
+        JobHandle.ScheduleBatchedJobs();
+        baking = true;
+    }
+    
+    private void CompleteBake()
+    {
+        if (!baking)
+            return;
+        
+        bakeHandle.Complete();
+        bakingIds.Dispose();
+        foreach (var mesh in bakingMeshes)
+        {
+            bakedMeshes.Add(mesh);
+        }
+        bakingMeshes.Clear();
+        baking = false;
+    }
+    
+    /// <summary>
+    /// Adds the colliders whose meshes are cooked, until the budget is used up
+    /// </summary>
+    private void Attach(List<PendingCollider> pending, float budgetMilliseconds)
+    {
+        for (int i = pending.Count - 1; i >= 0; i--)
+        {
+            if (frameTimer.IsRunning && frameTimer.Elapsed.TotalMilliseconds >= budgetMilliseconds)
+                return;
+            
+            PendingCollider entry = pending[i];
+            if (entry.target != null && !bakedMeshes.Contains(entry.mesh))
+                continue;
+            
+            // Remove by swapping with the last entry; order within a storey does not matter
+            pending[i] = pending[pending.Count - 1];
+            pending.RemoveAt(pending.Count - 1);
+            pendingCount--;
+            
+            if (entry.target == null || entry.target.GetComponent<MeshCollider>() != null)
+                continue;
+            
+            MeshCollider collider = entry.target.AddComponent<MeshCollider>();
+            collider.sharedMesh = entry.mesh;
+        }
+    }
+    
+    /// <summary>
+    /// Finds the player's storey (the highest one at or below the player) and the window around it.
+    /// Storey elevations are in building space and are moved into world space through the building root,
+    /// so a building placed above or below the world origin still selects the right storey.
+    /// Returns false if there is no player or storey to go by.
+    /// </summary>
+    private bool UpdateActiveStoreys()
+    {
+        if (organizer == null)
+            return false;
+        
+        if (organizer.Storeys.Count != storeyCount)
+        {
+            storeyCount = organizer.Storeys.Count;
+            storeysByElevation.Clear();
+            storeyElevations.Clear();
+            foreach (var storey in organizer.Storeys)
+            {
+                storeysByElevation.Add(storey.Key);
+            }
+            storeysByElevation.Sort((a, b) => organizer.Storeys[a].elevation.CompareTo(organizer.Storeys[b].elevation));
+            foreach (string storeyId in storeysByElevation)
+            {
+                storeyElevations.Add(organizer.Storeys[storeyId].elevation);
+            }
+            playerStorey = -1;
+        }
+        
+        Transform viewer = player;
+        if (viewer == null && Camera.main != null)
+        {
+            viewer = Camera.main.transform;
+        }
+        if (viewer == null || storeysByElevation.Count == 0)
+            return false;
+        
+        Transform root = organizer.buildingRoot != null ? organizer.buildingRoot : organizer.transform;
+        Matrix4x4 buildingToWorld = root.localToWorldMatrix;
+        
+        // Small tolerance so standing on a floor slab counts as being on its storey
+        float height = viewer.position.y + 0.1f;
+        int storey = 0;
+        while (storey + 1 < storeyElevations.Count &&
+               buildingToWorld.MultiplyPoint3x4(new Vector3(0f, storeyElevations[storey + 1], 0f)).y <= height)
+        {
+            storey++;
+        }
+        
+        if (storey == playerStorey)
+            return true;
+        
+        playerStorey = storey;
+        activeStoreys.Clear();
+        int first = Mathf.Max(0, storey - storeyMargin);
+        int last = Mathf.Min(storeysByElevation.Count - 1, storey + storeyMargin);
+        for (int i = first; i <= last; i++)
+        {
+            activeStoreys.Add(storeysByElevation[i]);
+        }
+        return true;
+    }
+}
\ No newline at end of file
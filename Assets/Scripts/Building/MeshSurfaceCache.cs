@@ -0,0 +1,236 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+using Unity.Burst;
+using Unity.Collections;
+using Unity.Jobs;
+using Unity.Mathematics;
+using UnityEngine.SceneManagement;
+
+/// <summary>
+/// Orientation of a component's dominant face in world space
+/// </summary>
+public enum SurfaceOrientation
+{
+    Vertical,   // Walls, windows, doors
+    Upward,     // Floors, roofs
+    Downward    // Ceilings, soffits
+}
+
+/// <summary>
+/// World-space surface area and dominant face of a mesh at a given scale.
+/// Computed once per (sharedMesh, scale) in a Burst job from Mesh.AcquireReadOnlyMeshData and shared by every
+/// instance, so area queries never copy vertex or index arrays to the managed heap. Entries are keyed by mesh
+/// instance ID (the cache never keeps a mesh alive) and dropped when a scene unloads or a building is imported.
+/// Main thread only.
+/// </summary>
+public static class MeshSurfaceCache
+{
+    // Scales are compared at 0.1% resolution so float noise in lossyScale does not defeat the cache
+    private const float ScaleQuantization = 1000f;
+    
+    // Area per axis direction: +X, -X, +Y, -Y, +Z, -Z, then the total
+    private const int DirectionCount = 6;
+    private const int ResultLength = DirectionCount + 1;
+    
+    // A face whose world normal is within ~45° of vertical counts as horizontal
+    private const float HorizontalNormalThreshold = 0.7071f;
+    
+    public struct MeshSurface
+    {
+        public float area;          // m², all triangles
+        public float faceArea;      // m², triangles facing the dominant direction (one side of a wall or slab)
+        public Vector3 faceNormal;  // Dominant direction in mesh space
+    }
+    
+    private readonly struct CacheKey : IEquatable<CacheKey>
+    {
+        public readonly int meshId;
+        private readonly int3 scale;
+        
+        public CacheKey(Mesh mesh, Vector3 scale)
+        {
+            meshId = mesh.GetInstanceID();
+            this.scale = (int3)math.round((float3)scale * ScaleQuantization);
+        }
+        
+        public bool Equals(CacheKey other) => meshId == other.meshId && scale.Equals(other.scale);
+        public override bool Equals(object obj) => obj is CacheKey other && Equals(other);
+        public override int GetHashCode() => (meshId * 397) ^ scale.GetHashCode();
+    }
+    
+    private static readonly Dictionary<CacheKey, MeshSurface> cache = new Dictionary<CacheKey, MeshSurface>();
+    
+    private static readonly Vector3[] directions =
+    {
+        Vector3.right, Vector3.left, Vector3.up, Vector3.down, Vector3.forward, Vector3.back
+    };
+    
+    public static int Count => cache.Count;
+    
+    [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.SubsystemRegistration)]
+    private static void Initialize()
+    {
+        // Also runs on entering play mode without a domain reload, so nothing survives from the last session
+        cache.Clear();
+        SceneManager.sceneUnloaded -= OnSceneUnloaded;
+        SceneManager.sceneUnloaded += OnSceneUnloaded;
+    }
+    
+    private static void OnSceneUnloaded(Scene scene)
+    {
+        // Meshes of the unloaded scene are gone; entries of meshes still in use are recomputed on demand
+        cache.Clear();
+    }
+    
+    /// <summary>
+    /// Returns the surface of a mesh scaled by the given (lossy) scale, computing it on first use.
+    /// Returns false if the mesh is not readable.
+    /// </summary>
+    public static bool TryGet(Mesh mesh, Vector3 scale, out MeshSurface surface)
+    {
+        surface = default;
+        if (mesh == null)
+            return false;
+        
+        CacheKey key = new CacheKey(mesh, scale);
+        if (cache.TryGetValue(key, out surface))
+            return true;
+        
+        if (!mesh.isReadable)
+            return false;
+        
+        surface = Compute(mesh, scale);
+        cache.Add(key, surface);
+        return true;
+    }
+    
+    /// <summary>
+    /// Classifies a world-space face normal
+    /// </summary>
+    public static SurfaceOrientation GetOrientation(Vector3 worldNormal)
+    {
+        if (worldNormal.y > HorizontalNormalThreshold)
+            return SurfaceOrientation.Upward;
+        if (worldNormal.y < -HorizontalNormalThreshold)
+            return SurfaceOrientation.Downward;
+        return SurfaceOrientation.Vertical;
+    }
+    
+    /// <summary>
+    /// Drops cached results for a mesh whose geometry was modified at runtime
+    /// </summary>
+    public static void Invalidate(Mesh mesh)
+    {
+        if (mesh == null)
+            return;
+        
+        int meshId = mesh.GetInstanceID();
+        List<CacheKey> stale = null;
+        foreach (var entry in cache)
+        {
+            if (entry.Key.meshId == meshId)
+            {
+                stale ??= new List<CacheKey>();
+                stale.Add(entry.Key);
+            }
+        }
+        
+        if (stale == null)
+            return;
+        
+        foreach (var key in stale)
+        {
+            cache.Remove(key);
+        }
+    }
+    
+    public static void Clear()
+    {
+        cache.Clear();
+    }
+    
+    private static MeshSurface Compute(Mesh mesh, Vector3 scale)
+    {
+        using (Mesh.MeshDataArray meshData = Mesh.AcquireReadOnlyMeshData(mesh))
+        using (NativeArray<float> result = new NativeArray<float>(ResultLength, Allocator.TempJob))
+        {
+            var job = new SurfaceAreaJob
+            {
+                meshData = meshData,
+                scale = scale,
+                result = result
+            };
+            job.Schedule().Complete();
+            
+            int dominant = 0;
+            for (int d = 1; d < DirectionCount; d++)
+            {
+                if (result[d] > result[dominant])
+                    dominant = d;
+            }
+            
+            return new MeshSurface
+            {
+                area = result[DirectionCount],
+                faceArea = result[dominant],
+                faceNormal = directions[dominant]
+            };
+        }
+    }
+    
+    /// <summary>
+    /// Sums scaled triangle areas, binned by the axis direction each triangle faces.
+    /// Under a diagonal scale S, the cross product of two edges scales by the cofactor of S, (sy·sz, sx·sz, sx·sy),
+    /// so each triangle's world area is exact rather than an approximation from two scale axes.
+    /// </summary>
+    [BurstCompile]
+    private struct SurfaceAreaJob : IJob
+    {
+        [ReadOnly] public Mesh.MeshDataArray meshData;
+        public float3 scale;
+        public NativeArray<float> result;
+        
+        public void Execute()
+        {
+            Mesh.MeshData data = meshData[0];
+            float3 cofactor = new float3(scale.y * scale.z, scale.x * scale.z, scale.x * scale.y);
+            
+            NativeArray<Vector3> positions = new NativeArray<Vector3>(data.vertexCount, Allocator.Temp);
+            data.GetVertices(positions);
+            
+            float total = 0f;
+            for (int s = 0; s < data.subMeshCount; s++)
+            {
+                var subMesh = data.GetSubMesh(s);
+                if (subMesh.topology != MeshTopology.Triangles)
+                    continue;
+                
+                NativeArray<int> indices = new NativeArray<int>(subMesh.indexCount, Allocator.Temp);
+                data.GetIndices(indices, s);
+                
+                for (int i = 0; i + 2 < indices.Length; i += 3)
+                {
+                    float3 v1 = positions[indices[i]];
+                    float3 v2 = positions[indices[i + 1]];
+                    float3 v3 = positions[indices[i + 2]];
+                    
+                    float3 normal = math.cross(v2 - v1, v3 - v1) * cofactor;
+                    float area = math.length(normal) * 0.5f;
+                    total += area;
+                    
+                    // Bin by the dominant axis of the scaled normal
+                    float3 magnitude = math.abs(normal);
+                    int axis = magnitude.x >= magnitude.y && magnitude.x >= magnitude.z ? 0 : (magnitude.y >= magnitude.z ? 1 : 2);
+                    int direction = axis * 2 + (normal[axis] < 0f ? 1 : 0);
+                    result[direction] += area;
+                }
+                
+                indices.Dispose();
+            }
+            
+            positions.Dispose();
+            result[DirectionCount] = total;
+        }
+    }
+}
\ No newline at end of file
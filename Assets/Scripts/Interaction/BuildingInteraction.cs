@@ -1,18 +1,172 @@
-using System.Collections;
-using System.Collections.Generic;
 using UnityEngine;
+using UnityEngine.EventSystems;
 
+/// <summary>
+/// Points at building components, highlights the one under the pointer and opens the material
+/// selection UI for it on click. Picks go through the organizer's spatial index, so components need
+/// no colliders to be selectable; physics raycasts are only used while the index is not available.
+/// </summary>
 public class BuildingInteraction : MonoBehaviour
 {
-    // Start is called before the first frame update
+    [Header("Pointer")]
+    [Tooltip("Ray origin and direction (e.g. a controller); if empty, the main camera through the mouse position")]
+    public Transform pointer;
+    public float maxDistance = 50.0f;
+    [Tooltip("Input Manager button that selects the pointed component")]
+    public string selectButton = "Fire1";
+    public bool highlightHovered = true;
+    [Tooltip("The hovered component is picked again once the ray origin moves this far (meters)")]
+    public float repickDistance = 0.01f;
+    [Tooltip("The hovered component is picked again once the ray direction turns this far (degrees)")]
+    public float repickAngle = 0.1f;
+    
+    [Header("Fallback")]
+    [Tooltip("Use physics raycasts against colliders while the spatial index is not built")]
+    public bool useColliderFallback = true;
+    public LayerMask colliderLayers = ~0;
+    
+    [Header("References")]
+    public BuildingOrganizer organizer;
+    public MaterialSelectionUI materialSelectionUI;
+    
+    private BuildingComponent hoveredComponent;
+    
+    // Last picked ray; the pick is reused while the pointer holds still
+    private Ray lastPickRay;
+    private ComponentSpatialIndex lastPickIndex;
+    private bool hasLastPick;
+    
+    public BuildingComponent HoveredComponent => hoveredComponent;
+    
     void Start()
     {
+        if (organizer == null)
+        {
+            organizer = FindObjectOfType<BuildingOrganizer>();
+        }
         
+        if (materialSelectionUI == null)
+        {
+            materialSelectionUI = FindObjectOfType<MaterialSelectionUI>(true);
+        }
     }
 
-    // Update is called once per frame
     void Update()
     {
+        if (!TryGetPointerRay(out Ray ray))
+        {
+            SetHovered(null);
+            hasLastPick = false;
+            return;
+        }
         
+        // Pointer over UI (desktop): the UI gets the click
+        if (pointer == null && EventSystem.current != null && EventSystem.current.IsPointerOverGameObject())
+        {
+            SetHovered(null);
+            hasLastPick = false;
+            return;
+        }
+        
+        BuildingComponent component = hoveredComponent;
+        if (NeedsPick(ray))
+        {
+            Pick(ray, out component);
+            SetHovered(component);
+        }
+        
+        if (component != null && !string.IsNullOrEmpty(selectButton) && Input.GetButtonDown(selectButton) && materialSelectionUI != null)
+        {
+            materialSelectionUI.ShowForComponent(component);
+        }
+    }
+    
+    void OnDisable()
+    {
+        SetHovered(null);
+        hasLastPick = false;
+    }
+    
+    /// <summary>
+    /// Nearest component hit by a ray, through the spatial index or, without one, colliders
+    /// </summary>
+    public bool Pick(Ray ray, out BuildingComponent component)
+    {
+        component = null;
+        
+        ComponentSpatialIndex index = organizer != null ? organizer.SpatialIndex : null;
+        if (index != null && index.IsCreated)
+            return index.Raycast(ray, maxDistance, out component, out _);
+        
+        if (!useColliderFallback || !Physics.Raycast(ray, out RaycastHit hit, maxDistance, colliderLayers, QueryTriggerInteraction.Ignore))
+            return false;
+        
+        // Combined meshes resolve the hit triangle to the component it came from
+        CombinedMeshChunk chunk = hit.collider.GetComponent<CombinedMeshChunk>();
+        component = chunk != null ? chunk.GetComponentAtTriangle(hit.triangleIndex) : hit.collider.GetComponentInParent<BuildingComponent>();
+        return component != null;
+    }
+    
+    /// <summary>
+    /// True unless the ray is close to the last picked one and the index and hovered component are unchanged.
+    /// Collider fallback picks run every frame, since colliders may move.
+    /// </summary>
+    private bool NeedsPick(Ray ray)
+    {
+        ComponentSpatialIndex index = organizer != null ? organizer.SpatialIndex : null;
+        if (index == null || !index.IsCreated)
+        {
+            hasLastPick = false;
+            return true;
+        }
+        
+        // The hovered component was destroyed (Unity null) or the index was rebuilt
+        bool hoveredDestroyed = hoveredComponent == null && !ReferenceEquals(hoveredComponent, null);
+        if (hasLastPick && index == lastPickIndex && !hoveredDestroyed &&
+            (ray.origin - lastPickRay.origin).sqrMagnitude <= repickDistance * repickDistance &&
+            Vector3.Angle(ray.direction, lastPickRay.direction) <= repickAngle)
+            return false;
+        
+        lastPickRay = ray;
+        lastPickIndex = index;
+        hasLastPick = true;
+        return true;
+    }
+    
+    private bool TryGetPointerRay(out Ray ray)
+    {
+        if (pointer != null)
+        {
+            ray = new Ray(pointer.position, pointer.forward);
+            return true;
+        }
+        
+        Camera camera = Camera.main;
+        if (camera == null)
+        {
+            ray = default;
+            return false;
+        }
+        
+        ray = camera.ScreenPointToRay(Input.mousePosition);
+        return true;
+    }
+    
+    private void SetHovered(BuildingComponent component)
+    {
+        if (component == hoveredComponent)
+            return;
+        
+        if (highlightHovered && hoveredComponent != null)
+        {
+            hoveredComponent.SetHighlight(false);
+        }
+        
+        hoveredComponent = component;
+        
+        if (highlightHovered && hoveredComponent != null)
+        {
+            hoveredComponent.SetHighlight(true);
+        }
     }
-}
+}
\ No newline at end of file
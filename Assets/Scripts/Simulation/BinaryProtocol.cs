@@ -0,0 +1,241 @@
+using System;
+using System.Buffers.Binary;
+
+/// <summary>
+/// Wire encoding of simulation messages, negotiated at REGISTER time
+/// </summary>
+public enum MessageEncoding
+{
+    Json,
+    Binary
+}
+
+/// <summary>
+/// Fixed-layout binary encoding of the high-volume simulation messages.
+/// Every binary message starts with a 4-byte header: Magic, message type, Version, reserved.
+/// All fields are little-endian; components, zones and materials are referenced by the indices
+/// announced in INDEX messages (see SimulationIndexTable) instead of their GlobalIds and names.
+/// Binary messages require length-prefixed framing.
+/// </summary>
+public static class BinaryProtocol
+{
+    // Never the first byte of a JSON message
+    public const byte Magic = 0xB5;
+    public const byte Version = 1;
+    public const int HeaderSize = 4;
+    
+    public enum MessageType : byte
+    {
+        ComponentUpdate = 1,    // ComponentUpdateRecord, then layerCount MaterialLayerRecords
+        ZoneUpdate = 2,         // ZoneUpdateRecord
+        EnvironmentUpdate = 3,  // EnvironmentUpdateRecord
+        ComponentBatchUpdate = 4, // Component count (int), then per component as in ComponentUpdate
+        ComponentResults = 5,   // Server to client: result count (int), then count ComponentResults
+        EnvironmentDeltaUpdate = 6, // EnvironmentField mask (int), then one float per set bit in bit order
+        ComponentStateSync = 7  // Client to server after reconnecting: state count (int), then count ComponentResults
+    }
+    
+    public const int ComponentBatchHeaderSize = HeaderSize + 4;
+    public const int ComponentResultsHeaderSize = HeaderSize + 4;
+    public const int ComponentStateSyncHeaderSize = HeaderSize + 4;
+    public const int EnvironmentDeltaMaxSize = HeaderSize + 4 + EnvironmentPublisher.FieldCount * 4;
+    
+    /// <summary>
+    /// True if a received payload is a binary message rather than JSON
+    /// </summary>
+    public static bool IsBinary(ReadOnlySpan<byte> payload)
+    {
+        return payload.Length >= HeaderSize && payload[0] == Magic;
+    }
+    
+    public static MessageType GetMessageType(ReadOnlySpan<byte> payload)
+    {
+        return (MessageType)payload[1];
+    }
+    
+    public static void WriteHeader(Span<byte> destination, MessageType type)
+    {
+        destination[0] = Magic;
+        destination[1] = (byte)type;
+        destination[2] = Version;
+        destination[3] = 0;
+    }
+    
+    public static void WriteInt(Span<byte> destination, int offset, int value)
+    {
+        BinaryPrimitives.WriteInt32LittleEndian(destination.Slice(offset, 4), value);
+    }
+    
+    public static void WriteFloat(Span<byte> destination, int offset, float value)
+    {
+        BinaryPrimitives.WriteInt32LittleEndian(destination.Slice(offset, 4), BitConverter.SingleToInt32Bits(value));
+    }
+    
+    public static int ReadInt(ReadOnlySpan<byte> source, int offset)
+    {
+        return BinaryPrimitives.ReadInt32LittleEndian(source.Slice(offset, 4));
+    }
+    
+    public static float ReadFloat(ReadOnlySpan<byte> source, int offset)
+    {
+        return BitConverter.Int32BitsToSingle(BinaryPrimitives.ReadInt32LittleEndian(source.Slice(offset, 4)));
+    }
+    
+    /// <summary>
+    /// Size of one encoded component (record and layers, without a message header)
+    /// </summary>
+    public static int GetComponentRecordSize(int layerCount)
+    {
+        return ComponentUpdateRecord.Size + layerCount * MaterialLayerRecord.Size;
+    }
+    
+    /// <summary>
+    /// Encodes a component record followed by its layers. Returns the number of bytes written.
+    /// </summary>
+    public static int EncodeComponentRecord(Span<byte> destination, in ComponentUpdateRecord record, MaterialLayerRecord[] layers)
+    {
+        record.Write(destination);
+        int offset = ComponentUpdateRecord.Size;
+        
+        for (int i = 0; i < record.layerCount; i++)
+        {
+            layers[i].Write(destination.Slice(offset));
+            offset += MaterialLayerRecord.Size;
+        }
+        return offset;
+    }
+    
+    /// <summary>
+    /// Writes the header of a COMPONENT_BATCH_UPDATE; the component records follow. Returns the number of bytes written.
+    /// </summary>
+    public static int WriteComponentBatchHeader(Span<byte> destination, int componentCount)
+    {
+        WriteHeader(destination, MessageType.ComponentBatchUpdate);
+        WriteInt(destination, HeaderSize, componentCount);
+        return ComponentBatchHeaderSize;
+    }
+    
+    /// <summary>
+    /// Encodes a ZONE_UPDATE into destination. Returns the number of bytes written.
+    /// </summary>
+    public static int EncodeZoneUpdate(Span<byte> destination, in ZoneUpdateRecord record)
+    {
+        WriteHeader(destination, MessageType.ZoneUpdate);
+        record.Write(destination.Slice(HeaderSize));
+        return HeaderSize + ZoneUpdateRecord.Size;
+    }
+    
+    /// <summary>
+    /// Encodes an ENVIRONMENT_UPDATE into destination. Returns the number of bytes written.
+    /// </summary>
+    public static int EncodeEnvironmentUpdate(Span<byte> destination, in EnvironmentUpdateRecord record)
+    {
+        WriteHeader(destination, MessageType.EnvironmentUpdate);
+        record.Write(destination.Slice(HeaderSize));
+        return HeaderSize + EnvironmentUpdateRecord.Size;
+    }
+    
+    /// <summary>
+    /// Encodes an ENVIRONMENT_DELTA_UPDATE carrying only the given fields; values are in field bit order.
+    /// Returns the number of bytes written.
+    /// </summary>
+    public static int EncodeEnvironmentDelta(Span<byte> destination, EnvironmentField fields, float[] values)
+    {
+        WriteHeader(destination, MessageType.EnvironmentDeltaUpdate);
+        WriteInt(destination, HeaderSize, (int)fields);
+        
+        int offset = HeaderSize + 4;
+        for (int i = 0; i < EnvironmentPublisher.FieldCount; i++)
+        {
+            if ((fields & (EnvironmentField)(1 << i)) != 0)
+            {
+                WriteFloat(destination, offset, values[i]);
+                offset += 4;
+            }
+        }
+        return offset;
+    }
+}
+
+/// <summary>
+/// COMPONENT_UPDATE body: component index, U-value (W/m²·K), total thickness (m), layer count
+/// </summary>
+public struct ComponentUpdateRecord
+{
+    public const int Size = 16;
+    
+    public int componentIndex;
+    public float uValue;
+    public float thickness;
+    public int layerCount;
+    
+    public void Write(Span<byte> destination)
+    {
+        BinaryProtocol.WriteInt(destination, 0, componentIndex);
+        BinaryProtocol.WriteFloat(destination, 4, uValue);
+        BinaryProtocol.WriteFloat(destination, 8, thickness);
+        BinaryProtocol.WriteInt(destination, 12, layerCount);
+    }
+}
+
+/// <summary>
+/// One material layer of a COMPONENT_UPDATE, exterior first: material index, thickness (m),
+/// conductivity (W/m·K), density (kg/m³), specific heat (J/kg·K)
+/// </summary>
+public struct MaterialLayerRecord
+{
+    public const int Size = 20;
+    
+    public int materialIndex;
+    public float thickness;
+    public float thermalConductivity;
+    public float density;
+    public float specificHeat;
+    
+    public void Write(Span<byte> destination)
+    {
+        BinaryProtocol.WriteInt(destination, 0, materialIndex);
+        BinaryProtocol.WriteFloat(destination, 4, thickness);
+        BinaryProtocol.WriteFloat(destination, 8, thermalConductivity);
+        BinaryProtocol.WriteFloat(destination, 12, density);
+        BinaryProtocol.WriteFloat(destination, 16, specificHeat);
+    }
+}
+
+/// <summary>
+/// ZONE_UPDATE body: zone index, air temperature (°C)
+/// </summary>
+public struct ZoneUpdateRecord
+{
+    public const int Size = 8;
+    
+    public int zoneIndex;
+    public float airTemperature;
+    
+    public void Write(Span<byte> destination)
+    {
+        BinaryProtocol.WriteInt(destination, 0, zoneIndex);
+        BinaryProtocol.WriteFloat(destination, 4, airTemperature);
+    }
+}
+
+/// <summary>
+/// ENVIRONMENT_UPDATE body: outside temperature (°C), outside humidity (%), wind speed (m/s), simulation time scale
+/// </summary>
+public struct EnvironmentUpdateRecord
+{
+    public const int Size = 16;
+    
+    public float outsideTemperature;
+    public float outsideHumidity;
+    public float windSpeed;
+    public float timeScale;
+    
+    public void Write(Span<byte> destination)
+    {
+        BinaryProtocol.WriteFloat(destination, 0, outsideTemperature);
+        BinaryProtocol.WriteFloat(destination, 4, outsideHumidity);
+        BinaryProtocol.WriteFloat(destination, 8, windSpeed);
+        BinaryProtocol.WriteFloat(destination, 12, timeScale);
+    }
+}
\ No newline at end of file
@@ -1,42 +1,139 @@
 using UnityEngine;
 using System;
+using System.Buffers;
+using System.IO;
 using System.Net.Sockets;
 using System.Text;
 using System.Threading;
 using System.Collections.Generic;
 using System.Collections.Concurrent;
+using Newtonsoft.Json.Linq;
 
 /// <summary>
-/// Handles TCP/IP communication with an external simulation server.
+/// Handles communication with an external simulation server over TCP/IP, or over a Unix domain socket
+/// or shared memory when the server runs on the same machine (see ISimulationTransport).
 /// </summary>
 public class BuildingSimulationClient : MonoBehaviour
 {
     [Header("Connection Settings")]
+    public SimulationTransportKind transport = SimulationTransportKind.Tcp;
     public string serverIP = "127.0.0.1";
     public int serverPort = 8080;
+    [Tooltip("UnixSocket transport: path of the server's socket")]
+    public string unixSocketPath = "/tmp/building_simulation.sock";
+    [Tooltip("SharedMemory transport: path of the memory-mapped file created by the server")]
+    public string sharedMemoryPath = "/dev/shm/building_simulation";
     public bool connectOnStart = true;
+    [Tooltip("Delay before the first reconnect attempt, in seconds; doubles with every failed attempt")]
     public float reconnectInterval = 5f;
+    [Tooltip("Upper bound of the reconnect delay, in seconds")]
+    public float maxReconnectInterval = 60f;
+    [Tooltip("A connection that lasted this many seconds resets the reconnect delay")]
+    public float stableConnectionSeconds = 30f;
+    [Tooltip("Message delimiting on the wire; must match the server. Unframed matches servers that predate framing; length-prefixed is needed for the binary encoding.")]
+    public MessageFraming framing = MessageFraming.Unframed;
+    [Tooltip("Largest accepted inbound message in bytes; larger frames drop the connection")]
+    public int maxMessageBytes = 16 * 1024 * 1024;
+    [Tooltip("Upper bound of queued messages coalesced into a single socket write, in bytes")]
+    public int maxWriteBytes = 256 * 1024;
+    [Tooltip("Offer the binary encoding at REGISTER time (requires length-prefixed framing); JSON is used if the server declines")]
+    public bool preferBinaryEncoding = true;
+    
+    [Header("Backpressure")]
+    [Tooltip("Outgoing data messages queued at most; the overflow policy applies beyond that")]
+    public int maxQueuedMessages = 1024;
+    public SendOverflowPolicy overflowPolicy = SendOverflowPolicy.CoalesceByComponent;
+    [Tooltip("BlockProducer: longest a background sending thread waits for room before the oldest message is dropped (the main thread never waits)")]
+    public int blockTimeoutMilliseconds = 100;
     
     [Header("Debug")]
     public bool logMessages = true;
     
-    // Connection state
-    private TcpClient client;
-    private NetworkStream stream;
+    // Connection state. The connect work item publishes the connection under connectionGate, so a
+    // Disconnect that runs while it is connecting either sees the whole connection or cancels it.
+    private readonly object connectionGate = new object();
+    private ISimulationTransport activeTransport;
+    private Stream stream;
+    private volatile bool connecting;
+    private volatile bool isConnected;
     private Thread receiveThread;
+    private Thread sendThread;
+    private CancellationTokenSource connectionCancellation;
     private bool shouldRun = true;
     
-    // Message queues
-    private ConcurrentQueue<string> sendQueue = new ConcurrentQueue<string>();
+    // Reconnect backoff
+    private int reconnectAttempt;
+    private int connectedAtTickCount;
+    
+    // Cached main-thread callbacks, so background threads do not allocate a delegate per dispatch
+    private Action raiseConnected;
+    private Action connectionLostCallback;
+    private Action scheduleConnectCallback;
+    
+    // Message queues: REGISTER and INDEX messages are never dropped and go out ahead of queued data
+    private OutboundMessageQueue sendQueue;
+    private ConcurrentQueue<OutboundMessage> controlQueue = new ConcurrentQueue<OutboundMessage>();
     private ConcurrentQueue<string> receiveQueue = new ConcurrentQueue<string>();
+    private readonly AutoResetEvent sendSignal = new AutoResetEvent(false);
+    
+    // Send metrics, updated by the producers and the sender thread
+    private long droppedWhileDisconnected;
+    private long droppedEncodingMismatch;
+    private long bytesInFlight;
+    private long bytesSent;
+    private long messagesSent;
     
     // Public properties
-    public bool connected { get; private set; } = false;
+    public bool connected => isConnected;
+    public MessageEncoding NegotiatedEncoding { get; private set; } = MessageEncoding.Json;
+    
+    /// <summary>
+    /// Component, zone and material indices for binary messages on the current connection
+    /// </summary>
+    public SimulationIndexTable Indices { get; } = new SimulationIndexTable();
+    
+    /// <summary>
+    /// Component results decoded on the receive thread, applied by BuildingSimulationManager
+    /// </summary>
+    public SimulationResultBuffer Results { get; } = new SimulationResultBuffer();
+    public int SendQueueDepth => sendQueue.Count + controlQueue.Count;
+    
+    /// <summary>
+    /// Messages discarded by the overflow policy or sent while disconnected
+    /// </summary>
+    public long DroppedMessages => sendQueue.DroppedCount + Interlocked.Read(ref droppedWhileDisconnected);
+    
+    /// <summary>
+    /// Binary messages dropped because the connection negotiated JSON (a caller not checking NegotiatedEncoding)
+    /// </summary>
+    public long EncodingMismatchDrops => Interlocked.Read(ref droppedEncodingMismatch);
+    
+    /// <summary>
+    /// Queued messages replaced by a newer state of the same component or zone
+    /// </summary>
+    public long CoalescedMessages => sendQueue.CoalescedCount;
+    public long BytesInFlight => Interlocked.Read(ref bytesInFlight);
+    public long BytesSent => Interlocked.Read(ref bytesSent);
+    public long MessagesSent => Interlocked.Read(ref messagesSent);
     
     // Events
     public event Action OnConnected;
     public event Action OnDisconnected;
     public event Action<string> OnMessageReceived;
+    public event Action<MessageEncoding> OnEncodingNegotiated;
+    
+    void Awake()
+    {
+        sendQueue = new OutboundMessageQueue(maxQueuedMessages)
+        {
+            Policy = overflowPolicy,
+            BlockTimeoutMilliseconds = blockTimeoutMilliseconds
+        };
+        
+        raiseConnected = () => OnConnected?.Invoke();
+        connectionLostCallback = OnConnectionLost;
+        scheduleConnectCallback = ScheduleConnect;
+    }
     
     void Start()
     {
@@ -57,9 +154,6 @@ public class BuildingSimulationClient : MonoBehaviour
                 ProcessReceivedMessage(message);
             }
         }
-        
-        // Send queued messages
-        SendQueuedMessages();
     }
     
     void OnDestroy()
@@ -73,13 +167,27 @@ public class BuildingSimulationClient : MonoBehaviour
     /// </summary>
     public void Connect()
     {
-        if (connected) return;
+        if (connected || connecting) return;
+        
+        // Encoding and indices are negotiated again for every connection
+        NegotiatedEncoding = MessageEncoding.Json;
+        Indices.Clear();
+        Results.Clear();
         
         try
         {
-            client = new TcpClient();
-            client.BeginConnect(serverIP, serverPort, ConnectCallback, null);
-            LogDebug("Connecting to server...");
+            ISimulationTransport connectingTransport = CreateTransport();
+            CancellationTokenSource cancellation = new CancellationTokenSource();
+            
+            lock (connectionGate)
+            {
+                activeTransport = connectingTransport;
+                connectionCancellation = cancellation;
+                connecting = true;
+            }
+            
+            ThreadPool.QueueUserWorkItem(_ => ConnectTransport(connectingTransport, cancellation));
+            LogDebug($"Connecting to {connectingTransport}...");
         }
         catch (Exception e)
         {
@@ -88,99 +196,329 @@ public class BuildingSimulationClient : MonoBehaviour
         }
     }
     
-    private void ConnectCallback(IAsyncResult ar)
+    private ISimulationTransport CreateTransport()
     {
+        switch (transport)
+        {
+            case SimulationTransportKind.UnixSocket:
+                return new UnixSocketSimulationTransport(unixSocketPath);
+            case SimulationTransportKind.SharedMemory:
+                return new SharedMemorySimulationTransport(sharedMemoryPath);
+            default:
+                return new TcpSimulationTransport(serverIP, serverPort);
+        }
+    }
+    
+    /// <summary>
+    /// Thread pool: opens the transport, then starts the receive and send threads. If Disconnect or
+    /// OnDestroy cancelled the attempt meanwhile, the new connection is closed instead of published.
+    /// A failed or cancelled attempt disposes its token source; a published connection hands it to Disconnect.
+    /// </summary>
+    private void ConnectTransport(ISimulationTransport connectingTransport, CancellationTokenSource cancellation)
+    {
+        CancellationToken cancellationToken = cancellation.Token;
+        Stream connectedStream = null;
+        
         try
         {
-            client.EndConnect(ar);
-            connected = true;
-            stream = client.GetStream();
+            connectedStream = connectingTransport.Connect();
             
-            LogDebug("Connected to server");
+            lock (connectionGate)
+            {
+                if (cancellationToken.IsCancellationRequested)
+                    throw new OperationCanceledException(cancellationToken);
             
-            // Start receive thread
-            receiveThread = new Thread(ReceiveData);
-            receiveThread.IsBackground = true;
-            receiveThread.Start();
+                // Nothing queued for an earlier connection is replayed; the manager resyncs current state instead
+                sendQueue.Clear();
+                ClearControlQueue();
             
-            // Notify on main thread
-            MainThreadDispatcher.Enqueue(() => OnConnected?.Invoke());
+                // Registration goes out first
+                string framingName = framing == MessageFraming.LengthPrefixed ? "length_prefixed" : (framing == MessageFraming.NewlineDelimited ? "newline" : "none");
+                string encodings = preferBinaryEncoding && framing == MessageFraming.LengthPrefixed ? "[\"binary\",\"json\"]" : "[\"json\"]";
+                EnqueueControl($"{{\"type\":\"REGISTER\",\"clientType\":\"unity_vr\",\"framing\":\"{framingName}\",\"encodings\":{encodings}}}");
+                
+                stream = connectedStream;
+                connectedAtTickCount = Environment.TickCount;
+                
+                // Start receive and send threads
+                receiveThread = new Thread(() => ReceiveData(connectedStream, connectingTransport, cancellationToken));
+                receiveThread.IsBackground = true;
+                receiveThread.Start();
+                
+                sendThread = new Thread(() => SendData(connectedStream, cancellationToken));
+                sendThread.IsBackground = true;
+                sendThread.Start();
+                
+                isConnected = true;
+                connecting = false;
+            }
+            
+            LogDebug("Connected to server");
             
-            // Send registration message
-            SendNetworkMessage("{\"type\":\"REGISTER\",\"clientType\":\"unity_vr\"}");
+            // Notify on main thread
+            MainThreadDispatcher.Enqueue(raiseConnected);
         }
         catch (Exception e)
         {
-            LogDebug($"Connection failed: {e.Message}");
-            ScheduleReconnect();
+            bool cancelled = cancellationToken.IsCancellationRequested;
+            if (!cancelled)
+            {
+                LogDebug($"Connection failed: {e.Message}");
+            }
+            
+            // The attempt still owns the transport; Disconnect only closed it
+            connectedStream?.Close();
+            connectingTransport.Dispose();
+            
+            lock (connectionGate)
+            {
+                if (activeTransport == connectingTransport)
+                {
+                    activeTransport = null;
+                    connecting = false;
+                }
+                
+                // Disconnect already let go of a cancelled attempt's token source
+                if (connectionCancellation == cancellation)
+                {
+                    connectionCancellation = null;
+                }
+            }
+            cancellation.Dispose();
+            
+            if (!cancelled)
+            {
+                ScheduleReconnect();
+            }
         }
     }
     
-    private void ReceiveData()
+    /// <summary>
+    /// Reads component results the transport delivers out of band (shared memory) into Results.
+    /// Called on the main thread before results are applied; a no-op for socket transports.
+    /// </summary>
+    public void PollResultChannel()
     {
-        byte[] buffer = new byte[4096];
-        
-        while (shouldRun && connected)
+        if (connected && activeTransport is ISimulationResultChannel channel)
+        {
+            channel.TryReadResults(Results);
+        }
+    }
+    
+    /// <summary>
+    /// Receive thread: blocks on the socket and handles each complete message once.
+    /// Component results are decoded here into Results; other messages are queued for the main thread.
+    /// Cancelling the token closes the transport, which releases the blocking read.
+    /// </summary>
+    private void ReceiveData(Stream receiveStream, ISimulationTransport receiveTransport, CancellationToken cancellationToken)
+    {
+        using (cancellationToken.Register(() => receiveTransport.Close()))
+        using (MessageFrameReader reader = new MessageFrameReader(receiveStream, framing, maxMessageBytes))
         {
+            SimulationResultDecoder resultDecoder = new SimulationResultDecoder();
+            
             try
             {
-                if (stream.DataAvailable)
+                while (shouldRun && reader.ReadFrame(cancellationToken, out ArraySegment<byte> frame))
                 {
-                    int bytesRead = stream.Read(buffer, 0, buffer.Length);
-                    if (bytesRead > 0)
+                    if (BinaryProtocol.IsBinary(new ReadOnlySpan<byte>(frame.Array, frame.Offset, frame.Count)))
                     {
-                        string message = Encoding.UTF8.GetString(buffer, 0, bytesRead);
-                        receiveQueue.Enqueue(message);
+                        if (!resultDecoder.TryDecode(frame, Results))
+                        {
+                            LogDebug($"Ignoring binary message of type {frame.Array[frame.Offset + 1]}");
+                        }
+                        continue;
                     }
+                    
+                    // One string per complete message
+                    string message = Encoding.UTF8.GetString(frame.Array, frame.Offset, frame.Count);
+                    if (message.IndexOf(SimulationResultDecoder.ResultsMessageType, StringComparison.Ordinal) >= 0 &&
+                        resultDecoder.TryDecode(message, Results))
+                        continue;
+                    
+                    receiveQueue.Enqueue(message);
                 }
-                else
-                {
-                    Thread.Sleep(10);
-                }
+            }
+            catch (Exception e) when (cancellationToken.IsCancellationRequested && (e is IOException || e is ObjectDisposedException || e is SocketException))
+            {
+                // Socket closed by Disconnect
             }
             catch (Exception e)
             {
                 LogDebug($"Error receiving data: {e.Message}");
-                break;
             }
         }
         
         // Disconnect on thread exit
-        MainThreadDispatcher.Enqueue(Disconnect);
+        if (!cancellationToken.IsCancellationRequested)
+        {
+            MainThreadDispatcher.Enqueue(connectionLostCallback);
+        }
     }
     
-    private void SendQueuedMessages()
+    /// <summary>
+    /// Send thread: waits for queued messages and writes everything pending as one coalesced write
+    /// from a pooled buffer, so the main thread never touches the socket.
+    /// </summary>
+    private void SendData(Stream sendStream, CancellationToken cancellationToken)
     {
-        if (!connected || stream == null) return;
+        byte[] buffer = ArrayPool<byte>.Shared.Rent(Math.Max(maxWriteBytes, 4096));
+        WaitHandle[] waitHandles = { sendSignal, cancellationToken.WaitHandle };
+        OutboundMessage carried = default; // Message that did not fit into the previous write
+        bool hasCarried = false;
         
-        while (sendQueue.Count > 0)
+        try
         {
-            if (sendQueue.TryDequeue(out string message))
+            while (shouldRun && !cancellationToken.IsCancellationRequested)
             {
-                try
+                if (!hasCarried && controlQueue.IsEmpty && sendQueue.Count == 0)
                 {
-                    byte[] data = Encoding.UTF8.GetBytes(message);
-                    stream.Write(data, 0, data.Length);
-                    LogDebug($"Sent message: {message}");
+                    WaitHandle.WaitAny(waitHandles);
+                    continue;
+                }
+                
+                int length = 0;
+                int count = 0;
+                while (hasCarried || TryDequeue(out carried))
+                {
+                    hasCarried = true;
+                    int maxFrameLength = carried.MaxFrameLength;
+                    if (length + maxFrameLength > buffer.Length)
+                    {
+                        if (length > 0)
+                            break; // Flush what we have; this message starts the next write
+                        
+                        // Single message larger than the buffer
+                        ArrayPool<byte>.Shared.Return(buffer);
+                        buffer = ArrayPool<byte>.Shared.Rent(maxFrameLength);
+                    }
+                    
+                    length += carried.Write(framing, buffer, length);
+                    count++;
+                    carried.Release();
+                    hasCarried = false;
+                    
+                    // Without framing the server can only tell messages apart by write
+                    if (framing == MessageFraming.Unframed)
+                        break;
                 }
-                catch (Exception e)
+                
+                Interlocked.Add(ref bytesInFlight, length);
+                sendStream.Write(buffer, 0, length);
+                Interlocked.Add(ref bytesInFlight, -length);
+                Interlocked.Add(ref bytesSent, length);
+                Interlocked.Add(ref messagesSent, count);
+                
+                // Shrink back after an oversized message
+                if (buffer.Length > maxWriteBytes * 2)
                 {
-                    LogDebug($"Error sending message: {e.Message}");
-                    Disconnect();
-                    return;
+                    ArrayPool<byte>.Shared.Return(buffer);
+                    buffer = ArrayPool<byte>.Shared.Rent(Math.Max(maxWriteBytes, 4096));
                 }
             }
         }
+        catch (Exception e)
+        {
+            if (!cancellationToken.IsCancellationRequested)
+            {
+                LogDebug($"Error sending data: {e.Message}");
+                MainThreadDispatcher.Enqueue(connectionLostCallback);
+            }
+        }
+        finally
+        {
+            if (hasCarried)
+            {
+                carried.Release();
+            }
+            Interlocked.Exchange(ref bytesInFlight, 0);
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+    
+    /// <summary>
+    /// Sends a message to the simulation server. Messages carrying the complete state of one component
+    /// or zone pass a coalesce key (e.g. "component:&lt;GlobalId&gt;") so a newer state can replace them
+    /// while queued. Messages sent while disconnected are dropped; the manager resyncs after reconnecting.
+    /// </summary>
+    public void SendNetworkMessage(string message, string coalesceKey = null)
+    {
+        if (!connected)
+        {
+            Interlocked.Increment(ref droppedWhileDisconnected);
+            return;
+        }
+        
+        Enqueue(new OutboundMessage { text = message, coalesceKey = coalesceKey });
+    }
+    
+    /// <summary>
+    /// Sends a binary message (see BinaryProtocol). The payload must be rented from ArrayPool&lt;byte&gt;.Shared;
+    /// ownership passes to the client, which returns it once written. Pending INDEX entries are sent first.
+    /// </summary>
+    public void SendBinaryMessage(byte[] payload, int length, string coalesceKey = null)
+    {
+        if (!connected)
+        {
+            ArrayPool<byte>.Shared.Return(payload);
+            Interlocked.Increment(ref droppedWhileDisconnected);
+            return;
+        }
+        
+        if (NegotiatedEncoding != MessageEncoding.Binary)
+        {
+            ArrayPool<byte>.Shared.Return(payload);
+            if (Interlocked.Increment(ref droppedEncodingMismatch) == 1)
+            {
+                Debug.LogWarning("Binary message dropped: the server negotiated JSON encoding");
+            }
+            return;
+        }
+        
+        SendPendingIndices();
+        Enqueue(new OutboundMessage { payload = payload, length = length, coalesceKey = coalesceKey });
     }
     
     /// <summary>
-    /// Sends a message to the simulation server
+    /// Sends any INDEX entries interned since the last binary message
     /// </summary>
-    public void SendNetworkMessage(string message)
+    public void SendPendingIndices()
     {
         if (!connected) return;
         
+        string indexMessage = Indices.TakePendingMessage();
+        if (indexMessage != null)
+        {
+            EnqueueControl(indexMessage);
+        }
+    }
+    
+    private void Enqueue(OutboundMessage message)
+    {
         sendQueue.Enqueue(message);
+        sendSignal.Set();
+    }
+    
+    private void EnqueueControl(string message)
+    {
+        controlQueue.Enqueue(new OutboundMessage { text = message });
+        sendSignal.Set();
+    }
+    
+    /// <summary>
+    /// Next message for the send thread; control messages first
+    /// </summary>
+    private bool TryDequeue(out OutboundMessage message)
+    {
+        return controlQueue.TryDequeue(out message) || sendQueue.TryDequeue(out message);
+    }
+    
+    private void ClearControlQueue()
+    {
+        while (controlQueue.TryDequeue(out OutboundMessage dropped))
+        {
+            dropped.Release();
+        }
     }
     
     private void ProcessReceivedMessage(string message)
@@ -189,21 +527,67 @@ public class BuildingSimulationClient : MonoBehaviour
         // Here we just log it
         LogDebug($"Received message: {message}");
         
-        // Find the simulation manager to process the message
-        BuildingSimulationManager manager = FindObjectOfType<BuildingSimulationManager>();
-        if (manager != null)
+        // Encoding negotiation: {"type":"REGISTER_ACK","encoding":"binary"}
+        if (message.IndexOf("REGISTER_ACK", StringComparison.Ordinal) >= 0)
         {
-            // Process the message (would need JSON parsing based on your protocol)
-            // For now, this is just a placeholder
+            try
+            {
+                JObject ack = JObject.Parse(message);
+                if ((string)ack["type"] == "REGISTER_ACK")
+                {
+                    bool binary = (string)ack["encoding"] == "binary" && preferBinaryEncoding && framing == MessageFraming.LengthPrefixed;
+                    NegotiatedEncoding = binary ? MessageEncoding.Binary : MessageEncoding.Json;
+                    LogDebug($"Using {NegotiatedEncoding} encoding");
+                    OnEncodingNegotiated?.Invoke(NegotiatedEncoding);
+                }
+            }
+            catch (Exception e)
+            {
+                LogDebug($"Invalid REGISTER_ACK: {e.Message}");
+            }
         }
+        
+        // Component results never get here; they are decoded on the receive thread into Results
     }
     
     private void ScheduleReconnect()
     {
         if (!shouldRun) return;
         
-        LogDebug($"Scheduling reconnect in {reconnectInterval} seconds");
-        MainThreadDispatcher.Enqueue(() => Invoke("Connect", reconnectInterval));
+        MainThreadDispatcher.Enqueue(scheduleConnectCallback);
+    }
+    
+    /// <summary>
+    /// Schedules the next connection attempt with exponential backoff and jitter, so clients
+    /// do not retry a flapping server in lockstep
+    /// </summary>
+    private void ScheduleConnect()
+    {
+        if (!shouldRun || connected || IsInvoking(nameof(Connect))) return;
+        
+        float backoff = Mathf.Min(maxReconnectInterval, reconnectInterval * Mathf.Pow(2f, Mathf.Min(reconnectAttempt, 16)));
+        float delay = backoff * UnityEngine.Random.Range(0.5f, 1f);
+        reconnectAttempt++;
+        
+        LogDebug($"Scheduling reconnect attempt {reconnectAttempt} in {delay:F1} seconds");
+        Invoke(nameof(Connect), delay);
+    }
+    
+    /// <summary>
+    /// The receive or send thread lost the connection
+    /// </summary>
+    private void OnConnectionLost()
+    {
+        if (!connected) return;
+        
+        // Only a connection that stayed up resets the backoff; a flapping server keeps it growing
+        if (Environment.TickCount - connectedAtTickCount >= stableConnectionSeconds * 1000f)
+        {
+            reconnectAttempt = 0;
+        }
+        
+        Disconnect();
+        ScheduleReconnect();
     }
     
     /// <summary>
@@ -211,15 +595,52 @@ public class BuildingSimulationClient : MonoBehaviour
     /// </summary>
     public void Disconnect()
     {
-        if (!connected) return;
+        lock (connectionGate)
+        {
+            if (!connected && !connecting) return;
+        
+            // Closes the socket under the blocked read and wakes the sender; a pending connect gives up
+            connectionCancellation?.Cancel();
         
-        connected = false;
+            if (connecting)
+            {
+                // The connect work item disposes its transport once Connect returns; closing it here
+                // releases a Connect that is still blocked. The work item disposes the token source when it gives up.
+                activeTransport?.Close();
+                activeTransport = null;
+                connectionCancellation = null;
+                connecting = false;
+                LogDebug("Connection attempt cancelled");
+                return;
+            }
+            
+            isConnected = false;
+        }
         
         if (receiveThread != null && receiveThread.IsAlive)
         {
             receiveThread.Join(500);
-            receiveThread = null;
         }
+        receiveThread = null;
+        
+        if (sendThread != null && sendThread.IsAlive)
+        {
+            sendThread.Join(500);
+        }
+        sendThread = null;
+        
+        if (connectionCancellation != null)
+        {
+            connectionCancellation.Dispose();
+            connectionCancellation = null;
+        }
+        
+        // Messages queued for this connection are dropped
+        sendQueue.Clear();
+        ClearControlQueue();
+        
+        NegotiatedEncoding = MessageEncoding.Json;
+        Indices.Clear();
         
         if (stream != null)
         {
@@ -227,10 +648,10 @@ public class BuildingSimulationClient : MonoBehaviour
             stream = null;
         }
         
-        if (client != null)
+        if (activeTransport != null)
         {
-            client.Close();
-            client = null;
+            activeTransport.Dispose();
+            activeTransport = null;
         }
         
         LogDebug("Disconnected from server");
@@ -244,55 +665,4 @@ public class BuildingSimulationClient : MonoBehaviour
             Debug.Log($"[BuildingSimulationClient] {message}");
         }
     }
-}
-
-/// <summary>
-/// Utility class for executing actions on the main thread
-/// </summary>
-public class MainThreadDispatcher : MonoBehaviour
-{
-    private static Queue<Action> actionQueue = new Queue<Action>();
-    private static MainThreadDispatcher instance;
-    
-    void Awake()
-    {
-        if (instance == null)
-        {
-            instance = this;
-            DontDestroyOnLoad(gameObject);
-        }
-        else
-        {
-            Destroy(gameObject);
-        }
-    }
-    
-    void Update()
-    {
-        lock (actionQueue)
-        {
-            while (actionQueue.Count > 0)
-            {
-                actionQueue.Dequeue().Invoke();
-            }
-        }
-    }
-    
-    /// <summary>
-    /// Enqueues an action to be executed on the main thread
-    /// </summary>
-    public static void Enqueue(Action action)
-    {
-        if (instance == null)
-        {
-            // Create the dispatcher if it doesn't exist
-            GameObject dispatcherObject = new GameObject("MainThreadDispatcher");
-            instance = dispatcherObject.AddComponent<MainThreadDispatcher>();
-        }
-        
-        lock (actionQueue)
-        {
-            actionQueue.Enqueue(action);
-        }
-    }
 }
\ No newline at end of file
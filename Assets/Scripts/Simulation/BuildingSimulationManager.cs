@@ -1,5 +1,8 @@
 using UnityEngine;
+using System;
+using System.Buffers;
 using System.Collections.Generic;
+using Unity.Collections;
 using Newtonsoft.Json;
 
 /// <summary>
@@ -19,12 +22,98 @@ public class BuildingSimulationManager : MonoBehaviour
     public float windSpeed = 2.0f;
     public float simulationTimeScale = 1.0f;
     
+    [Header("Environment Publishing")]
+    [Tooltip("Send ENVIRONMENT_UPDATE messages automatically when the simulation fields above change")]
+    public bool publishEnvironmentChanges = true;
+    [Tooltip("Maximum environment messages per second (0 = every change)")]
+    public float environmentPublishRate = 4.0f;
+    [Tooltip("°C the outside temperature must move before it is sent")]
+    public float outsideTemperatureThreshold = 0.1f;
+    [Tooltip("% the outside humidity must move before it is sent")]
+    public float outsideHumidityThreshold = 0.5f;
+    [Tooltip("m/s the wind speed must move before it is sent")]
+    public float windSpeedThreshold = 0.1f;
+    public float timeScaleThreshold = 0.01f;
+    
+    [Header("Local Simulation")]
+    [Tooltip("Step the local thermal solver while the simulation server is not connected")]
+    public bool useLocalSolver = true;
+    [Tooltip("Lumped: steady-state U-value relaxation. Layered: transient conduction through each material layer.")]
+    public LocalThermalSolver.ThermalModel localThermalModel = LocalThermalSolver.ThermalModel.Layered;
+    public float indoorTemperature = 20.0f;
+    [Tooltip("°C a component's temperature must move before it is copied back to the BuildingComponent")]
+    public float localChangeThreshold = 0.01f;
+    [Tooltip("Outdoor air exchange of each space, in air changes per hour")]
+    public float zoneAirChangesPerHour = 0.5f;
+    [Tooltip("Heating/cooling coupling of each space to the indoor temperature, in W/K per m³ of air")]
+    public float zoneHvacConductance = 10.0f;
+    
+    [Header("Reconnect")]
+    [Tooltip("Components whose material and state are resent per frame after (re)connecting")]
+    public int resyncComponentsPerFrame = 500;
+    
+    [Header("Component Batches")]
+    [Tooltip("Seconds a BeginComponentBatch transaction may stay open before it is closed and flushed anyway")]
+    public float maxComponentBatchSeconds = 5.0f;
+    
     [Header("References")]
     public BuildingSimulationClient client;
+    public BuildingOrganizer organizer;
     
     // Cached component references
     private Dictionary<string, BuildingComponent> componentRegistry = new Dictionary<string, BuildingComponent>();
     
+    // Runtime state of registered components, by dense state index
+    private ComponentStateStore stateStore;
+    
+    // State indices by SimulationIndexTable index on the current connection (-1 until resolved)
+    private List<int> stateIndicesByWireIndex = new List<int>();
+    
+    // Offline/local thermal solver
+    private LocalThermalSolver localSolver;
+    private bool localSolverNeedsRebuild = false;
+    private float localSolverIndoorTemperature;
+    private bool localZoneStatePending = false;
+    
+    // Reused layer records for binary COMPONENT_UPDATE encoding
+    private MaterialLayerRecord[] layerRecords = new MaterialLayerRecord[8];
+    
+    // Material changes waiting for the end of the frame, in first-changed order
+    private HashSet<BuildingComponent> dirtyComponents = new HashSet<BuildingComponent>();
+    private List<BuildingComponent> dirtyComponentOrder = new List<BuildingComponent>();
+    private List<BuildingComponent> flushComponents = new List<BuildingComponent>();
+    private int componentBatchDepth = 0;
+    private float componentBatchOpenedAt;
+    
+    // Components still to be resent to a newly connected server, from resyncCursor on
+    private List<BuildingComponent> resyncComponents = new List<BuildingComponent>();
+    private List<BuildingComponent> resyncChunk = new List<BuildingComponent>();
+    private int resyncCursor = 0;
+    
+    // Rate-limited environment changes, with the current values in EnvironmentField bit order
+    private EnvironmentPublisher environmentPublisher = new EnvironmentPublisher();
+    private float[] environmentValues = new float[EnvironmentPublisher.FieldCount];
+    
+    /// <summary>
+    /// The active simulation manager, so components do not have to search the scene for it
+    /// </summary>
+    public static BuildingSimulationManager Instance { get; private set; }
+    
+    /// <summary>
+    /// Runtime state of every registered component in contiguous arrays, for jobs and visualization
+    /// </summary>
+    public ComponentStateStore State => stateStore;
+    
+    void Awake()
+    {
+        if (Instance == null)
+        {
+            Instance = this;
+        }
+        
+        stateStore = new ComponentStateStore();
+    }
+    
     void Start()
     {
         // Initialize client if needed
@@ -39,6 +128,13 @@ public class BuildingSimulationManager : MonoBehaviour
             }
         }
         
+        if (client != null)
+        {
+            client.OnConnected += OnClientConnected;
+            client.OnDisconnected += ResetComponentIndices;
+            client.OnEncodingNegotiated += OnEncodingNegotiated;
+        }
+        
         if (client != null && autoConnect)
         {
             client.serverIP = serverIP;
@@ -50,8 +146,325 @@ public class BuildingSimulationManager : MonoBehaviour
             }
         }
         
-        // Register all building components
-        RegisterAllComponents();
+        // Register all building components, waiting for a time-sliced import to finish first
+        if (organizer == null)
+        {
+            organizer = FindObjectOfType<BuildingOrganizer>();
+        }
+        
+        if (organizer != null && !organizer.IsImportComplete)
+        {
+            organizer.OnImportCompleted += RegisterAllComponents;
+        }
+        else
+        {
+            RegisterAllComponents();
+        }
+    }
+    
+    void Update()
+    {
+        ApplySimulationResults();
+        
+        if (publishEnvironmentChanges)
+        {
+            PublishEnvironmentChanges();
+        }
+        
+        if (!ShouldRunLocalSolver())
+        {
+            // Hand the locally simulated zone state to the server once it is reachable again
+            if (localZoneStatePending && client != null && client.connected)
+            {
+                BroadcastLocalZoneStates();
+            }
+            return;
+        }
+        
+        if (localSolver == null || localSolverNeedsRebuild)
+        {
+            RebuildLocalSolver();
+        }
+        
+        if (localSolverIndoorTemperature != indoorTemperature)
+        {
+            localSolver.SetInsideTemperature(indoorTemperature);
+            localSolverIndoorTemperature = indoorTemperature;
+        }
+        
+        localSolver.AirChangesPerHour = zoneAirChangesPerHour;
+        localSolver.HvacConductance = zoneHvacConductance;
+        
+        // Scheduled here and completed in LateUpdate so the step overlaps the rest of the frame
+        localSolver.ScheduleStep(localThermalModel, outsideTemperature, Time.deltaTime * simulationTimeScale, localChangeThreshold);
+        localZoneStatePending = localSolver.ZoneCount > 0;
+    }
+    
+    void LateUpdate()
+    {
+        if (localSolver != null)
+        {
+            localSolver.CompleteAndApply(stateStore);
+        }
+        
+        // A transaction left open (a missing EndComponentBatch) must not hold back updates forever
+        if (componentBatchDepth > 0 && Time.realtimeSinceStartup - componentBatchOpenedAt > maxComponentBatchSeconds)
+        {
+            Debug.LogWarning($"Component batch still open after {maxComponentBatchSeconds}s ({componentBatchDepth} unmatched BeginComponentBatch calls); flushing");
+            componentBatchDepth = 0;
+        }
+        
+        // One message per frame for all material changes, unless a batch transaction is still open
+        if (componentBatchDepth == 0)
+        {
+            ContinueResync();
+            FlushComponentUpdates();
+        }
+    }
+    
+    void OnDestroy()
+    {
+        if (Instance == this)
+        {
+            Instance = null;
+        }
+        
+        if (localSolver != null)
+        {
+            localSolver.Dispose();
+            localSolver = null;
+        }
+        
+        if (stateStore != null)
+        {
+            stateStore.Dispose();
+            stateStore = null;
+        }
+    }
+    
+    /// <summary>
+    /// Applies every component result received since the last frame in one pass
+    /// </summary>
+    private void ApplySimulationResults()
+    {
+        if (client == null)
+            return;
+        
+        client.PollResultChannel();
+        int count = client.Results.Swap(out ComponentResult[] results, out string[] ids);
+        for (int i = 0; i < count; i++)
+        {
+            ref ComponentResult result = ref results[i];
+            
+            int state;
+            if (result.componentIndex >= 0)
+            {
+                state = GetStateIndex(result.componentIndex);
+            }
+            else
+            {
+                // JSON results carry GlobalIds
+                componentRegistry.TryGetValue(ids[i] ?? string.Empty, out BuildingComponent component);
+                state = component != null ? component.StateIndex : -1;
+            }
+            
+            if (state < 0)
+                continue;
+            
+            // NaN marks a field the result did not include
+            if (!float.IsNaN(result.surfaceTemperature))
+                stateStore.SetSurfaceTemperature(state, result.surfaceTemperature);
+            if (!float.IsNaN(result.innerTemperature))
+                stateStore.SetInnerTemperature(state, result.innerTemperature);
+            if (!float.IsNaN(result.moistureContent))
+                stateStore.SetMoistureContent(state, result.moistureContent);
+        }
+    }
+    
+    /// <summary>
+    /// Maps a connection-local component index to its state index, caching the GlobalId lookup
+    /// </summary>
+    private int GetStateIndex(int wireIndex)
+    {
+        if (wireIndex < stateIndicesByWireIndex.Count && stateIndicesByWireIndex[wireIndex] >= 0)
+            return stateIndicesByWireIndex[wireIndex];
+        
+        string globalId = client.Indices.GetId(SimulationIndexTable.Kind.Component, wireIndex);
+        if (globalId == null || !componentRegistry.TryGetValue(globalId, out BuildingComponent component) || component == null)
+            return -1;
+        
+        SetStateIndex(wireIndex, component.StateIndex);
+        return component.StateIndex;
+    }
+    
+    private void SetStateIndex(int wireIndex, int state)
+    {
+        while (stateIndicesByWireIndex.Count <= wireIndex)
+        {
+            stateIndicesByWireIndex.Add(-1);
+        }
+        stateIndicesByWireIndex[wireIndex] = state;
+    }
+    
+    private void ResetComponentIndices()
+    {
+        stateIndicesByWireIndex.Clear();
+    }
+    
+    private void OnClientConnected()
+    {
+        ResetComponentIndices();
+        
+        // A new connection starts without any environment state
+        environmentPublisher.MarkDirty(EnvironmentField.All);
+        
+        // Resend every component from current state, spread over frames, rather than replaying old messages
+        resyncComponents.Clear();
+        resyncComponents.AddRange(componentRegistry.Values);
+        resyncCursor = 0;
+    }
+    
+    /// <summary>
+    /// Sends the material and runtime state of the next resyncComponentsPerFrame components
+    /// </summary>
+    private void ContinueResync()
+    {
+        if (resyncCursor >= resyncComponents.Count)
+            return;
+        
+        if (client == null || !client.connected)
+        {
+            resyncComponents.Clear();
+            resyncCursor = 0;
+            return;
+        }
+        
+        resyncChunk.Clear();
+        int end = Mathf.Min(resyncComponents.Count, resyncCursor + Mathf.Max(resyncComponentsPerFrame, 1));
+        for (; resyncCursor < end; resyncCursor++)
+        {
+            BuildingComponent component = resyncComponents[resyncCursor];
+            if (component != null && component.StateStore == stateStore)
+            {
+                resyncChunk.Add(component);
+                if (dirtyComponents.Add(component))
+                {
+                    dirtyComponentOrder.Add(component);
+                }
+            }
+        }
+        
+        // Materials first, so the server knows the components the state refers to
+        FlushComponentUpdates();
+        SendComponentStates(resyncChunk);
+        resyncChunk.Clear();
+        
+        if (resyncCursor >= resyncComponents.Count)
+        {
+            resyncComponents.Clear();
+            resyncCursor = 0;
+        }
+    }
+    
+    /// <summary>
+    /// Sends the runtime state held in the state store for the given components
+    /// </summary>
+    private void SendComponentStates(List<BuildingComponent> components)
+    {
+        if (components.Count == 0)
+            return;
+        
+        NativeArray<float> surface = stateStore.SurfaceTemperature;
+        NativeArray<float> inner = stateStore.InnerTemperature;
+        NativeArray<float> moisture = stateStore.MoistureContent;
+        
+        if (client.NegotiatedEncoding == MessageEncoding.Binary)
+        {
+            int size = BinaryProtocol.ComponentStateSyncHeaderSize + components.Count * ComponentResult.Size;
+            byte[] payload = ArrayPool<byte>.Shared.Rent(size);
+            BinaryProtocol.WriteHeader(payload, BinaryProtocol.MessageType.ComponentStateSync);
+            BinaryProtocol.WriteInt(payload, BinaryProtocol.HeaderSize, components.Count);
+            
+            int offset = BinaryProtocol.ComponentStateSyncHeaderSize;
+            foreach (var component in components)
+            {
+                int state = component.StateIndex;
+                ComponentResult record = new ComponentResult
+                {
+                    componentIndex = client.Indices.Intern(SimulationIndexTable.Kind.Component, component.globalId),
+                    surfaceTemperature = surface[state],
+                    innerTemperature = inner[state],
+                    moistureContent = moisture[state]
+                };
+                record.Write(new Span<byte>(payload, offset, ComponentResult.Size));
+                offset += ComponentResult.Size;
+            }
+            
+            client.SendBinaryMessage(payload, offset);
+            return;
+        }
+        
+        List<Dictionary<string, object>> states = new List<Dictionary<string, object>>(components.Count);
+        foreach (var component in components)
+        {
+            int state = component.StateIndex;
+            states.Add(new Dictionary<string, object>
+            {
+                { "componentId", component.globalId },
+                { "surfaceTemperature", surface[state] },
+                { "innerTemperature", inner[state] },
+                { "moistureContent", moisture[state] }
+            });
+        }
+        
+        Dictionary<string, object> message = new Dictionary<string, object>
+        {
+            { "type", "COMPONENT_STATE_SYNC" },
+            { "components", states }
+        };
+        client.SendNetworkMessage(JsonConvert.SerializeObject(message));
+    }
+    
+    /// <summary>
+    /// With the binary encoding, announces an index for every registered component up front,
+    /// so the server can address results to components that never sent an update
+    /// </summary>
+    private void OnEncodingNegotiated(MessageEncoding encoding)
+    {
+        stateIndicesByWireIndex.Clear();
+        if (encoding != MessageEncoding.Binary)
+            return;
+        
+        foreach (var component in componentRegistry.Values)
+        {
+            if (component == null)
+                continue;
+            
+            int index = client.Indices.Intern(SimulationIndexTable.Kind.Component, component.globalId);
+            SetStateIndex(index, component.StateIndex);
+        }
+        client.SendPendingIndices();
+    }
+    
+    private bool ShouldRunLocalSolver()
+    {
+        return useLocalSolver && componentRegistry.Count > 0 && (client == null || !client.connected);
+    }
+    
+    /// <summary>
+    /// Packs all registered components into the local solver
+    /// </summary>
+    private void RebuildLocalSolver()
+    {
+        if (localSolver == null)
+        {
+            localSolver = new LocalThermalSolver();
+        }
+        
+        // Spaces become zone air nodes coupled to their boundary components
+        localSolver.Build(componentRegistry.Values, indoorTemperature, organizer != null ? organizer.Spaces : null);
+        localSolverIndoorTemperature = indoorTemperature;
+        localSolverNeedsRebuild = false;
     }
     
     /// <summary>
@@ -65,77 +478,404 @@ public class BuildingSimulationManager : MonoBehaviour
             if (!string.IsNullOrEmpty(component.globalId))
             {
                 componentRegistry[component.globalId] = component;
+                stateStore.Register(component);
             }
         }
         
         Debug.Log($"BuildingSimulationManager registered {componentRegistry.Count} components");
+        
+        // Repack the local solver with the new registry
+        localSolverNeedsRebuild = true;
     }
     
     /// <summary>
-    /// Called when a component's material has changed
+    /// Called when a component's material has changed.
+    /// Without custom material data the change is batched: repeated changes to a component within a frame
+    /// (or an open Begin/EndComponentBatch transaction) are sent once, in one COMPONENT_BATCH_UPDATE at the end of the frame.
     /// </summary>
     public void OnComponentMaterialChanged(BuildingComponent component, Dictionary<string, object> materialData = null)
     {
-        if (client == null || !client.connected)
+        if (component == null)
             return;
-            
-        // Generate material data if not provided
+        
         if (materialData == null)
         {
-            materialData = new Dictionary<string, object>();
+            if (dirtyComponents.Add(component))
+            {
+                dirtyComponentOrder.Add(component);
+            }
+            return;
+        }
+        
+        // Custom payloads are sent as they are
+        RefreshLocalSolver(component);
+        
+        if (client == null || !client.connected)
+            return;
             
-            if (!component.isMultiLayer && component.currentMaterial != null)
+        Dictionary<string, object> message = new Dictionary<string, object>
+        {
+            { "type", "COMPONENT_UPDATE" },
+            { "componentId", component.globalId },
+            { "data", materialData }
+        };
+        
+        client.SendNetworkMessage(JsonConvert.SerializeObject(message));
+    }
+    
+    /// <summary>
+    /// Opens a batch transaction: material changes are held until the matching EndComponentBatch,
+    /// then sent at the end of that frame. Transactions may nest and span frames, up to maxComponentBatchSeconds.
+    /// The returned scope ends the transaction when disposed: using (manager.BeginComponentBatch()) { ... }
+    /// </summary>
+    public ComponentBatchScope BeginComponentBatch()
+    {
+        if (componentBatchDepth == 0)
+        {
+            componentBatchOpenedAt = Time.realtimeSinceStartup;
+        }
+        componentBatchDepth++;
+        return new ComponentBatchScope(this);
+    }
+    
+    /// <summary>
+    /// Closes a batch transaction opened with BeginComponentBatch
+    /// </summary>
+    public void EndComponentBatch()
+    {
+        if (componentBatchDepth > 0)
+        {
+            componentBatchDepth--;
+        }
+    }
+    
+    /// <summary>
+    /// Sends all pending material changes now, as a single message
+    /// </summary>
+    public void FlushComponentUpdates()
+    {
+        if (dirtyComponentOrder.Count == 0)
+            return;
+        
+        // Drop components destroyed since they were marked
+        flushComponents.Clear();
+        foreach (var component in dirtyComponentOrder)
+        {
+            if (component != null)
             {
-                materialData["materialName"] = component.currentMaterial.materialName;
-                materialData["thermalConductivity"] = component.currentMaterial.thermalConductivity;
-                materialData["density"] = component.currentMaterial.density;
-                materialData["specificHeat"] = component.currentMaterial.specificHeatCapacity;
-                materialData["uValue"] = component.GetUValue();
-                materialData["thickness"] = component.componentThickness;
+                flushComponents.Add(component);
+                RefreshLocalSolver(component);
             }
-            else if (component.isMultiLayer)
+        }
+        dirtyComponents.Clear();
+        dirtyComponentOrder.Clear();
+        
+        if (flushComponents.Count > 0 && client != null && client.connected)
+        {
+            if (client.NegotiatedEncoding == MessageEncoding.Binary)
             {
-                List<Dictionary<string, object>> layers = new List<Dictionary<string, object>>();
-                
-                foreach (var layer in component.materialLayers)
+                SendComponentUpdatesBinary(flushComponents);
+            }
+            else
+            {
+                SendComponentUpdatesJson(flushComponents);
+            }
+        }
+        
+        flushComponents.Clear();
+    }
+    
+    /// <summary>
+    /// Keeps the local solver's packed layers in sync; a changed layer count needs a full repack
+    /// </summary>
+    private void RefreshLocalSolver(BuildingComponent component)
+    {
+        if (localSolver != null && !localSolver.RefreshComponent(component))
+        {
+            localSolverNeedsRebuild = true;
+        }
+    }
+    
+    /// <summary>
+    /// Sends one COMPONENT_UPDATE, or a COMPONENT_BATCH_UPDATE listing every component, as JSON
+    /// </summary>
+    private void SendComponentUpdatesJson(List<BuildingComponent> components)
+    {
+        Dictionary<string, object> message;
+        string coalesceKey = null;
+        
+        if (components.Count == 1)
+        {
+            message = new Dictionary<string, object>
+            {
+                { "type", "COMPONENT_UPDATE" },
+                { "componentId", components[0].globalId },
+                { "data", CreateMaterialData(components[0]) }
+            };
+            coalesceKey = "component:" + components[0].globalId;
+        }
+        else
+        {
+            List<Dictionary<string, object>> updates = new List<Dictionary<string, object>>(components.Count);
+            foreach (var component in components)
+            {
+                updates.Add(new Dictionary<string, object>
                 {
-                    if (layer.material != null)
+                    { "componentId", component.globalId },
+                    { "data", CreateMaterialData(component) }
+                });
+            }
+            
+            message = new Dictionary<string, object>
+            {
+                { "type", "COMPONENT_BATCH_UPDATE" },
+                { "components", updates }
+            };
+        }
+        
+        client.SendNetworkMessage(JsonConvert.SerializeObject(message), coalesceKey);
+    }
+    
+    /// <summary>
+    /// Generates the JSON material data of a component
+    /// </summary>
+    private static Dictionary<string, object> CreateMaterialData(BuildingComponent component)
+    {
+        Dictionary<string, object> materialData = new Dictionary<string, object>();
+        
+        if (!component.isMultiLayer && component.currentMaterial != null)
+        {
+            materialData["materialName"] = component.currentMaterial.materialName;
+            materialData["thermalConductivity"] = component.currentMaterial.thermalConductivity;
+            materialData["density"] = component.currentMaterial.density;
+            materialData["specificHeat"] = component.currentMaterial.specificHeatCapacity;
+            materialData["uValue"] = component.GetUValue();
+            materialData["thickness"] = component.componentThickness;
+        }
+        else if (component.isMultiLayer)
+        {
+            List<Dictionary<string, object>> layers = new List<Dictionary<string, object>>();
+            
+            foreach (var layer in component.materialLayers)
+            {
+                if (layer.material != null)
+                {
+                    Dictionary<string, object> layerData = new Dictionary<string, object>
                     {
-                        Dictionary<string, object> layerData = new Dictionary<string, object>
-                        {
-                            {"materialName", layer.material.materialName},
-                            {"thermalConductivity", layer.material.thermalConductivity},
-                            {"density", layer.material.density},
-                            {"specificHeat", layer.material.specificHeatCapacity},
-                            {"thickness", layer.thickness},
-                            {"layerOrder", layer.layerOrder}
-                        };
-                        
-                        layers.Add(layerData);
-                    }
+                        {"materialName", layer.material.materialName},
+                        {"thermalConductivity", layer.material.thermalConductivity},
+                        {"density", layer.material.density},
+                        {"specificHeat", layer.material.specificHeatCapacity},
+                        {"thickness", layer.thickness},
+                        {"layerOrder", layer.layerOrder}
+                    };
+                    
+                    layers.Add(layerData);
                 }
+            }
+            
+            materialData["layers"] = layers;
+            materialData["uValue"] = component.GetUValue();
+            materialData["totalThickness"] = component.GetTotalThickness();
+        }
+        
+        return materialData;
+    }
+    
+    /// <summary>
+    /// Encodes components as one binary COMPONENT_UPDATE or COMPONENT_BATCH_UPDATE, with interned component and material indices
+    /// </summary>
+    private void SendComponentUpdatesBinary(List<BuildingComponent> components)
+    {
+        bool batch = components.Count > 1;
+        
+        int size = batch ? BinaryProtocol.ComponentBatchHeaderSize : BinaryProtocol.HeaderSize;
+        foreach (var component in components)
+        {
+            size += BinaryProtocol.GetComponentRecordSize(CountLayerRecords(component));
+        }
+        
+        byte[] payload = ArrayPool<byte>.Shared.Rent(size);
+        int length;
+        if (batch)
+        {
+            length = BinaryProtocol.WriteComponentBatchHeader(payload, components.Count);
+        }
+        else
+        {
+            BinaryProtocol.WriteHeader(payload, BinaryProtocol.MessageType.ComponentUpdate);
+            length = BinaryProtocol.HeaderSize;
+        }
+        
+        foreach (var component in components)
+        {
+            ComponentUpdateRecord record = CreateComponentRecord(client.Indices, component);
+            length += BinaryProtocol.EncodeComponentRecord(new Span<byte>(payload, length, size - length), record, layerRecords);
+        }
+        
+        client.SendBinaryMessage(payload, length, batch ? null : "component:" + components[0].globalId);
+    }
+    
+    private static int CountLayerRecords(BuildingComponent component)
+    {
+        if (!component.isMultiLayer)
+            return component.currentMaterial != null ? 1 : 0;
+        
+        int count = 0;
+        foreach (var layer in component.materialLayers)
+        {
+            if (layer.material != null)
+                count++;
+        }
+        return count;
+    }
+    
+    /// <summary>
+    /// Fills layerRecords for a component and returns its fixed-layout record
+    /// </summary>
+    private ComponentUpdateRecord CreateComponentRecord(SimulationIndexTable indices, BuildingComponent component)
+    {
+        int layerCount = 0;
+        float thickness;
+        
+        if (!component.isMultiLayer)
+        {
+            if (component.currentMaterial != null)
+            {
+                layerRecords[0] = CreateLayerRecord(indices, component.currentMaterial, component.componentThickness);
+                layerCount = 1;
+            }
+            thickness = component.componentThickness;
+        }
+        else
+        {
+            foreach (var layer in component.materialLayers)
+            {
+                if (layer.material == null)
+                    continue;
                 
-                materialData["layers"] = layers;
-                materialData["uValue"] = component.GetUValue();
-                materialData["totalThickness"] = component.GetTotalThickness();
+                if (layerCount == layerRecords.Length)
+                {
+                    Array.Resize(ref layerRecords, layerRecords.Length * 2);
+                }
+                layerRecords[layerCount++] = CreateLayerRecord(indices, layer.material, layer.thickness);
             }
+            thickness = component.GetTotalThickness();
         }
         
-        // Create message to send to simulation
-        Dictionary<string, object> message = new Dictionary<string, object>
+        return new ComponentUpdateRecord
         {
-            { "type", "COMPONENT_UPDATE" },
-            { "componentId", component.globalId },
-            { "data", materialData }
+            componentIndex = indices.Intern(SimulationIndexTable.Kind.Component, component.globalId),
+            uValue = component.GetUValue(),
+            thickness = thickness,
+            layerCount = layerCount
         };
+    }
+    
+    private static MaterialLayerRecord CreateLayerRecord(SimulationIndexTable indices, BuildingPhysicsMaterial material, float thickness)
+    {
+        return new MaterialLayerRecord
+        {
+            materialIndex = indices.Intern(SimulationIndexTable.Kind.Material, material.materialName),
+            thickness = thickness,
+            thermalConductivity = material.thermalConductivity,
+            density = material.density,
+            specificHeat = material.specificHeatCapacity
+        };
+    }
+    
+    /// <summary>
+    /// Broadcasts the manager's outside conditions, using the binary encoding when negotiated
+    /// </summary>
+    public void BroadcastEnvironmentState()
+    {
+        if (client == null || !client.connected)
+            return;
+        
+        ReadEnvironmentValues();
+        environmentPublisher.MarkPublished(environmentValues, EnvironmentField.All, Time.unscaledTime);
         
-        // Send message
-        if (client != null && client.connected)
+        if (client.NegotiatedEncoding == MessageEncoding.Binary)
         {
-            client.SendNetworkMessage(JsonConvert.SerializeObject(message));
+            EnvironmentUpdateRecord record = new EnvironmentUpdateRecord
+            {
+                outsideTemperature = outsideTemperature,
+                outsideHumidity = outsideHumidity,
+                windSpeed = windSpeed,
+                timeScale = simulationTimeScale
+            };
+            
+            byte[] payload = ArrayPool<byte>.Shared.Rent(BinaryProtocol.HeaderSize + EnvironmentUpdateRecord.Size);
+            int length = BinaryProtocol.EncodeEnvironmentUpdate(payload, record);
+            client.SendBinaryMessage(payload, length);
+            return;
         }
         
-        Debug.Log($"Sent material update for component {component.name} ({component.globalId})");
+        SendEnvironmentFields(EnvironmentField.All);
+    }
+    
+    /// <summary>
+    /// Marks environment fields to be sent with the next rate-limited publish, even if below their threshold
+    /// </summary>
+    public void MarkEnvironmentDirty(EnvironmentField fields = EnvironmentField.All)
+    {
+        environmentPublisher.MarkDirty(fields);
+    }
+    
+    /// <summary>
+    /// Sends the environment fields that moved past their thresholds, at most environmentPublishRate times per second
+    /// </summary>
+    private void PublishEnvironmentChanges()
+    {
+        if (client == null || !client.connected)
+            return;
+        
+        environmentPublisher.MaxPublishRate = environmentPublishRate;
+        environmentPublisher.SetThreshold(0, outsideTemperatureThreshold);
+        environmentPublisher.SetThreshold(1, outsideHumidityThreshold);
+        environmentPublisher.SetThreshold(2, windSpeedThreshold);
+        environmentPublisher.SetThreshold(3, timeScaleThreshold);
+        
+        ReadEnvironmentValues();
+        environmentPublisher.Track(environmentValues);
+        
+        EnvironmentField fields = environmentPublisher.TakeChanges(environmentValues, Time.unscaledTime);
+        if (fields != EnvironmentField.None)
+        {
+            SendEnvironmentFields(fields);
+        }
+    }
+    
+    /// <summary>
+    /// Sends the given fields of environmentValues only
+    /// </summary>
+    private void SendEnvironmentFields(EnvironmentField fields)
+    {
+        if (client.NegotiatedEncoding == MessageEncoding.Binary)
+        {
+            byte[] payload = ArrayPool<byte>.Shared.Rent(BinaryProtocol.EnvironmentDeltaMaxSize);
+            int length = BinaryProtocol.EncodeEnvironmentDelta(payload, fields, environmentValues);
+            client.SendBinaryMessage(payload, length);
+            return;
+        }
+        
+        Dictionary<string, object> stateData = new Dictionary<string, object>();
+        for (int i = 0; i < EnvironmentPublisher.FieldCount; i++)
+        {
+            if ((fields & (EnvironmentField)(1 << i)) != 0)
+            {
+                stateData[EnvironmentPublisher.GetFieldName(i)] = environmentValues[i];
+            }
+        }
+        BroadcastEnvironmentState(stateData);
+    }
+    
+    private void ReadEnvironmentValues()
+    {
+        environmentValues[0] = outsideTemperature;
+        environmentValues[1] = outsideHumidity;
+        environmentValues[2] = windSpeed;
+        environmentValues[3] = simulationTimeScale;
     }
     
     /// <summary>
@@ -159,6 +899,11 @@ public class BuildingSimulationManager : MonoBehaviour
     /// Broadcasts the state of a specific zone to the simulation
     /// </summary>
     public void BroadcastZoneState(string zoneId, Dictionary<string, object> zoneData)
+    {
+        SendZoneUpdateJson(zoneId, zoneData, null);
+    }
+    
+    private void SendZoneUpdateJson(string zoneId, Dictionary<string, object> zoneData, string coalesceKey)
     {
         if (client == null || !client.connected)
             return;
@@ -170,7 +915,67 @@ public class BuildingSimulationManager : MonoBehaviour
             { "data", zoneData }
         };
         
-        client.SendNetworkMessage(JsonConvert.SerializeObject(message));
+        client.SendNetworkMessage(JsonConvert.SerializeObject(message), coalesceKey);
+    }
+    
+    /// <summary>
+    /// Broadcasts the air temperature of a zone, using the binary encoding when negotiated
+    /// </summary>
+    public void BroadcastZoneState(string zoneId, float airTemperature)
+    {
+        if (client == null || !client.connected)
+            return;
+        
+        if (client.NegotiatedEncoding == MessageEncoding.Binary)
+        {
+            ZoneUpdateRecord record = new ZoneUpdateRecord
+            {
+                zoneIndex = client.Indices.Intern(SimulationIndexTable.Kind.Zone, zoneId),
+                airTemperature = airTemperature
+            };
+            
+            byte[] payload = ArrayPool<byte>.Shared.Rent(BinaryProtocol.HeaderSize + ZoneUpdateRecord.Size);
+            int length = BinaryProtocol.EncodeZoneUpdate(payload, record);
+            client.SendBinaryMessage(payload, length, "zone:" + zoneId);
+            return;
+        }
+        
+        Dictionary<string, object> zoneData = new Dictionary<string, object>
+        {
+            { "airTemperature", airTemperature }
+        };
+        SendZoneUpdateJson(zoneId, zoneData, "zone:" + zoneId);
+    }
+    
+    /// <summary>
+    /// Sends the air temperature of every zone simulated by the local solver
+    /// </summary>
+    public void BroadcastLocalZoneStates()
+    {
+        if (localSolver == null || client == null || !client.connected)
+            return;
+        
+        localSolver.CompleteAndApply(stateStore);
+        
+        for (int zone = 0; zone < localSolver.ZoneCount; zone++)
+        {
+            BroadcastZoneState(localSolver.GetZoneId(zone), localSolver.GetZoneTemperature(zone));
+        }
+        
+        localZoneStatePending = false;
+    }
+    
+    /// <summary>
+    /// Returns the locally simulated air temperature of a space
+    /// </summary>
+    public bool TryGetZoneTemperature(string spaceId, out float temperature)
+    {
+        temperature = indoorTemperature;
+        if (localSolver == null || string.IsNullOrEmpty(spaceId) || !localSolver.TryGetZoneIndex(spaceId, out int zone))
+            return false;
+        
+        temperature = localSolver.GetZoneTemperature(zone);
+        return true;
     }
     
     /// <summary>
@@ -188,28 +993,63 @@ public class BuildingSimulationManager : MonoBehaviour
         }
         
         // Update temperatures if provided
-        if (stateData.TryGetValue("surfaceTemperature", out object surfaceTempObj))
+        if (stateData.TryGetValue("surfaceTemperature", out object surfaceTempObj) && TryGetFloat(surfaceTempObj, out float surfaceTemp))
         {
-            if (surfaceTempObj is float surfaceTemp)
-            {
-                component.surfaceTemperature = surfaceTemp;
-            }
-            else if (float.TryParse(surfaceTempObj.ToString(), out float parsedTemp))
-            {
-                component.surfaceTemperature = parsedTemp;
-            }
+            component.surfaceTemperature = surfaceTemp;
         }
         
-        if (stateData.TryGetValue("innerTemperature", out object innerTempObj))
+        if (stateData.TryGetValue("innerTemperature", out object innerTempObj) && TryGetFloat(innerTempObj, out float innerTemp))
         {
-            if (innerTempObj is float innerTemp)
-            {
-                component.innerTemperature = innerTemp;
-            }
-            else if (float.TryParse(innerTempObj.ToString(), out float parsedTemp))
-            {
-                component.innerTemperature = parsedTemp;
-            }
+            component.innerTemperature = innerTemp;
+        }
+    }
+    
+    /// <summary>
+    /// Converts a boxed number (or numeric string) without going through ToString for numeric types
+    /// </summary>
+    private static bool TryGetFloat(object value, out float result)
+    {
+        switch (value)
+        {
+            case float f:
+                result = f;
+                return true;
+            case double d:
+                result = (float)d;
+                return true;
+            case int i:
+                result = i;
+                return true;
+            case long l:
+                result = l;
+                return true;
+            case string text:
+                return float.TryParse(text, System.Globalization.NumberStyles.Float, System.Globalization.CultureInfo.InvariantCulture, out result);
+            default:
+                result = 0f;
+                return false;
+        }
+    }
+}
+
+/// <summary>
+/// Ends a BuildingSimulationManager component batch when disposed; disposing more than once has no further effect
+/// </summary>
+public struct ComponentBatchScope : IDisposable
+{
+    private BuildingSimulationManager manager;
+    
+    public ComponentBatchScope(BuildingSimulationManager manager)
+    {
+        this.manager = manager;
+    }
+    
+    public void Dispose()
+    {
+        if (manager != null)
+        {
+            manager.EndComponentBatch();
+            manager = null;
         }
     }
 }
\ No newline at end of file
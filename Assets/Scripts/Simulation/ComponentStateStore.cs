@@ -0,0 +1,163 @@
+using System;
+using System.Collections.Generic;
+using Unity.Collections;
+
+/// <summary>
+/// Runtime state of all registered building components, stored as contiguous NativeArrays indexed by a
+/// dense component index assigned at registration. BuildingComponent's state properties read and write
+/// these arrays, so jobs, the network layer and visualization can scan whole-building state linearly.
+/// Main thread only; arrays are reallocated when the store grows, so do not keep them across registrations.
+/// </summary>
+public class ComponentStateStore : IDisposable
+{
+    private const int InitialCapacity = 1024;
+    
+    private NativeArray<float> surfaceTemperature;  // °C
+    private NativeArray<float> innerTemperature;    // °C
+    private NativeArray<float> moistureContent;
+    
+    // Dense index -> component (null while a slot is free)
+    private readonly List<BuildingComponent> components = new List<BuildingComponent>();
+    
+    // Released slots, reused by the next registrations before the store grows
+    private readonly Stack<int> freeSlots = new Stack<int>();
+    
+    // Property keys shared by all components, so thousands of imported components hold one copy of each name
+    private static readonly Dictionary<string, string> propertyKeys = new Dictionary<string, string>(StringComparer.Ordinal);
+    
+    public int Count => components.Count;
+    
+    /// <summary>
+    /// Incremented whenever a component is registered or released, so holders of state indices can tell
+    /// when theirs may be stale (a released slot can be handed to a different component)
+    /// </summary>
+    public int Version { get; private set; }
+    public bool IsCreated => surfaceTemperature.IsCreated;
+    
+    public NativeArray<float> SurfaceTemperature => surfaceTemperature;
+    public NativeArray<float> InnerTemperature => innerTemperature;
+    public NativeArray<float> MoistureContent => moistureContent;
+    
+    public ComponentStateStore(int capacity = InitialCapacity)
+    {
+        Allocate(Math.Max(capacity, 1));
+    }
+    
+    /// <summary>
+    /// Component at a dense index, or null if it was destroyed
+    /// </summary>
+    public BuildingComponent GetComponentAt(int index)
+    {
+        return components[index];
+    }
+    
+    /// <summary>
+    /// Assigns a component a free dense index (a released slot if there is one) and moves its current state into the store.
+    /// Returns the existing index for components already registered here.
+    /// </summary>
+    public int Register(BuildingComponent component)
+    {
+        if (component.StateStore == this)
+            return component.StateIndex;
+        
+        if (component.StateStore != null)
+        {
+            component.StateStore.Release(component);
+        }
+        
+        int index;
+        if (freeSlots.Count > 0)
+        {
+            index = freeSlots.Pop();
+            components[index] = component;
+        }
+        else
+        {
+            index = components.Count;
+            if (index == surfaceTemperature.Length)
+            {
+                Allocate(surfaceTemperature.Length * 2);
+            }
+            components.Add(component);
+        }
+        
+        surfaceTemperature[index] = component.surfaceTemperature;
+        innerTemperature[index] = component.innerTemperature;
+        moistureContent[index] = component.moistureContent;
+        
+        component.BindState(this, index);
+        Version++;
+        return index;
+    }
+    
+    /// <summary>
+    /// Hands a component's state back to its own fields and frees its slot
+    /// </summary>
+    public void Release(BuildingComponent component)
+    {
+        if (component.StateStore != this)
+            return;
+        
+        int index = component.StateIndex;
+        component.UnbindState(surfaceTemperature[index], innerTemperature[index], moistureContent[index]);
+        components[index] = null;
+        freeSlots.Push(index);
+        Version++;
+    }
+    
+    /// <summary>
+    /// Returns the shared instance of a property key (main thread only)
+    /// </summary>
+    public static string InternPropertyKey(string key)
+    {
+        if (key == null)
+            return null;
+        
+        if (!propertyKeys.TryGetValue(key, out string interned))
+        {
+            interned = key;
+            propertyKeys.Add(key, interned);
+        }
+        return interned;
+    }
+    
+    public void SetSurfaceTemperature(int index, float value) => surfaceTemperature[index] = value;
+    public void SetInnerTemperature(int index, float value) => innerTemperature[index] = value;
+    public void SetMoistureContent(int index, float value) => moistureContent[index] = value;
+    
+    public void Dispose()
+    {
+        // Components outliving the store keep their last state
+        for (int i = 0; i < components.Count; i++)
+        {
+            if (components[i] != null)
+            {
+                Release(components[i]);
+            }
+        }
+        components.Clear();
+        freeSlots.Clear();
+        
+        if (surfaceTemperature.IsCreated) surfaceTemperature.Dispose();
+        if (innerTemperature.IsCreated) innerTemperature.Dispose();
+        if (moistureContent.IsCreated) moistureContent.Dispose();
+    }
+    
+    private void Allocate(int capacity)
+    {
+        surfaceTemperature = Resize(surfaceTemperature, capacity);
+        innerTemperature = Resize(innerTemperature, capacity);
+        moistureContent = Resize(moistureContent, capacity);
+    }
+    
+    private NativeArray<float> Resize(NativeArray<float> array, int capacity)
+    {
+        NativeArray<float> resized = new NativeArray<float>(capacity, Allocator.Persistent);
+        if (array.IsCreated)
+        {
+            NativeArray<float>.Copy(array, resized, components.Count);
+            array.Dispose();
+        }
+        return resized;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+using System;
+
+/// <summary>
+/// Fields of the environment state. Also the field mask of binary ENVIRONMENT_DELTA_UPDATE messages.
+/// </summary>
+[Flags]
+public enum EnvironmentField
+{
+    None = 0,
+    OutsideTemperature = 1 << 0,
+    OutsideHumidity = 1 << 1,
+    WindSpeed = 1 << 2,
+    TimeScale = 1 << 3,
+    All = OutsideTemperature | OutsideHumidity | WindSpeed | TimeScale
+}
+
+/// <summary>
+/// Decides when environment changes are worth sending. A field becomes dirty when it moves past its
+/// threshold from the last published value, or when it is marked dirty explicitly. Dirty fields are
+/// released at most MaxPublishRate times per second, so continuous input (e.g. a slider scrubbed every
+/// frame) becomes a few messages per second. The last value always goes out once the rate allows.
+/// Main thread only.
+/// </summary>
+public class EnvironmentPublisher
+{
+    public const int FieldCount = 4;
+    
+    // JSON names, in field bit order
+    private static readonly string[] fieldNames = { "outsideTemperature", "outsideHumidity", "windSpeed", "simulationTimeScale" };
+    
+    private readonly float[] published = new float[FieldCount];
+    private readonly float[] thresholds = new float[FieldCount];
+    private EnvironmentField dirty = EnvironmentField.All; // Nothing published yet
+    private float lastPublishTime = float.NegativeInfinity;
+    
+    /// <summary>
+    /// Maximum messages per second; 0 publishes every change immediately
+    /// </summary>
+    public float MaxPublishRate { get; set; } = 4f;
+    
+    public EnvironmentField DirtyFields => dirty;
+    
+    public static string GetFieldName(int field)
+    {
+        return fieldNames[field];
+    }
+    
+    /// <summary>
+    /// Smallest change of a field that marks it dirty
+    /// </summary>
+    public void SetThreshold(int field, float threshold)
+    {
+        thresholds[field] = Math.Max(threshold, 0f);
+    }
+    
+    /// <summary>
+    /// Compares current values (in field bit order) against the last published ones
+    /// </summary>
+    public void Track(float[] values)
+    {
+        for (int i = 0; i < FieldCount; i++)
+        {
+            if (Math.Abs(values[i] - published[i]) > thresholds[i])
+            {
+                dirty |= (EnvironmentField)(1 << i);
+            }
+        }
+    }
+    
+    /// <summary>
+    /// Forces fields out with the next publish, regardless of their threshold
+    /// </summary>
+    public void MarkDirty(EnvironmentField fields)
+    {
+        dirty |= fields;
+    }
+    
+    /// <summary>
+    /// Returns the dirty fields if the rate limit allows a publish now, and records values as published.
+    /// Returns EnvironmentField.None if nothing is due.
+    /// </summary>
+    public EnvironmentField TakeChanges(float[] values, float time)
+    {
+        if (dirty == EnvironmentField.None)
+            return EnvironmentField.None;
+        
+        if (MaxPublishRate > 0f && time - lastPublishTime < 1f / MaxPublishRate)
+            return EnvironmentField.None;
+        
+        EnvironmentField fields = dirty;
+        MarkPublished(values, fields, time);
+        return fields;
+    }
+    
+    /// <summary>
+    /// Records fields as published outside TakeChanges (e.g. an explicit full broadcast)
+    /// </summary>
+    public void MarkPublished(float[] values, EnvironmentField fields, float time)
+    {
+        for (int i = 0; i < FieldCount; i++)
+        {
+            if ((fields & (EnvironmentField)(1 << i)) != 0)
+            {
+                published[i] = values[i];
+            }
+        }
+        dirty &= ~fields;
+        lastPublishTime = time;
+    }
+}
\ No newline at end of file
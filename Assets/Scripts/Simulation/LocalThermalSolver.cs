@@ -0,0 +1,1034 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+using Unity.Burst;
+using Unity.Collections;
+using Unity.Jobs;
+using Unity.Mathematics;
+
+/// <summary>
+/// Local thermal solver used when no external simulation server is available.
+/// All components and their material layers are packed into NativeArrays (struct-of-arrays) and
+/// stepped in a Burst-compiled parallel job. Only temperatures that moved past a threshold since
+/// they were last copied back are written to the BuildingComponents (scattered straight into the
+/// ComponentStateStore when every component has a slot there).
+/// Spaces become zone air nodes, connected to their boundary components through a CSR adjacency
+/// (zone -> boundary range) built once, so zones are stepped without any per-frame lookups.
+/// </summary>
+public class LocalThermalSolver : IDisposable
+{
+    public enum ThermalModel
+    {
+        Lumped,  // Steady-state U-value relaxation, identical to BuildingComponent.UpdateTemperature
+        Layered  // Transient 1D finite-difference conduction through every material layer
+    }
+    
+    // Job batch size for IJobParallelFor scheduling
+    private const int BatchSize = 256;
+    
+    // Surface film resistances (m²·K/W), EN ISO 6946 values for horizontal heat flow
+    private const float ExteriorSurfaceResistance = 0.04f;
+    private const float InteriorSurfaceResistance = 0.13f;
+    
+    // Layered model discretisation
+    private const float TargetNodeSpacing = 0.025f; // m
+    private const int MaxNodesPerLayer = 8;
+    
+    // Stand-in for components without any material: R = 1 m²·K/W (U = 1, as in GetUValue) and concrete-like heat capacity
+    private const float DefaultVolumetricHeatCapacity = 1.0e6f; // J/m³·K
+    private const float MinimumThickness = 0.01f;
+    
+    // Zone air nodes
+    private const float AirVolumetricHeatCapacity = 1206f; // J/m³·K (1.2 kg/m³ * 1005 J/kg·K)
+    private const float DefaultZoneVolume = 50f; // m³, for spaces without a volume property
+    private const int ZoneBatchSize = 64;
+    private static readonly string[] volumePropertyNames = { "NetVolume", "GrossVolume", "Volume" };
+    
+    // Component lookup
+    private readonly List<BuildingComponent> components = new List<BuildingComponent>();
+    private readonly Dictionary<BuildingComponent, int> componentIndices = new Dictionary<BuildingComponent, int>();
+    
+    // Zone lookup (space GlobalIds)
+    private readonly List<string> zoneIds = new List<string>();
+    private readonly Dictionary<string, int> zoneIndices = new Dictionary<string, int>();
+    
+    // Per-component state
+    private NativeArray<int> layerStart;
+    private NativeArray<int> layerCount;
+    private NativeArray<int> nodeStart;
+    private NativeArray<int> nodeCount;
+    private NativeArray<float> conductance;         // W/m²·K, derived from the layers
+    private NativeArray<float> exteriorConductance; // W/m²·K, outside air to the first node
+    private NativeArray<float> insideTemperature;   // °C, air temperature on the interior side
+    private NativeArray<float> outsideBoundaryTemperature; // °C, air temperature on the exterior side
+    private NativeArray<int> insideZone;            // Zone on the interior side, -1 for the indoor default
+    private NativeArray<int> outsideZone;           // Zone on the exterior side, -1 for outdoor air
+    private NativeArray<float> surfaceTemperature;  // °C
+    private NativeArray<float> innerTemperature;    // °C
+    private NativeArray<float> publishedSurfaceTemperature;
+    private NativeArray<float> publishedInnerTemperature;
+    private NativeArray<byte> changed;
+    private NativeArray<int> stateIndex;            // Slot in the ComponentStateStore, -1 if unregistered
+    private bool allComponentsInStore;
+    
+    // Store and store version stateIndex was read at; re-read whenever components register or release
+    private ComponentStateStore indexedStore;
+    private int indexedStoreVersion;
+    
+    // Per-layer state (exterior layer first)
+    private NativeArray<float> layerResistance;     // m²·K/W
+    private NativeArray<float> layerThickness;      // m
+    private NativeArray<float> layerConductivity;   // W/m·K
+    private NativeArray<float> layerHeatCapacity;   // J/m³·K (density * specific heat)
+    private NativeArray<int> layerNodeCount;
+    
+    // Per-node state for the layered model
+    private NativeArray<float> nodeCapacity;        // J/m²·K
+    private NativeArray<float> nodeConductance;     // W/m²·K to the next node (interior air for the last node)
+    private NativeArray<float> nodeTemperature;     // °C
+    private NativeArray<float> scratchUpper;        // Thomas algorithm modified super-diagonal
+    private NativeArray<float> scratchRhs;          // Thomas algorithm modified right-hand side
+    
+    // Zone graph: boundaries of zone z are zoneBoundaryStart[z] .. zoneBoundaryStart[z + 1] - 1
+    private NativeArray<int> zoneBoundaryStart;
+    private NativeArray<int> boundaryComponent;
+    private NativeArray<float> boundaryConductance; // W/K, boundary area over the interior film resistance
+    private NativeArray<byte> boundarySide;         // 0: the component's interior face, 1: its exterior face
+    private NativeArray<float> zoneVolume;          // m³
+    private NativeArray<float> zoneTemperature;     // °C
+    
+    private float defaultInsideTemperature;
+    
+    private JobHandle stepHandle;
+    private bool stepScheduled;
+    private bool resultsPending;
+    
+    public int ComponentCount => components.Count;
+    public int LayerCount => layerResistance.IsCreated ? layerResistance.Length : 0;
+    public int NodeCount => nodeTemperature.IsCreated ? nodeTemperature.Length : 0;
+    public int ZoneCount => zoneIds.Count;
+    public bool IsCreated => surfaceTemperature.IsCreated;
+    
+    /// <summary>
+    /// Outdoor air exchange of every zone, in air changes per hour
+    /// </summary>
+    public float AirChangesPerHour { get; set; } = 0.5f;
+    
+    /// <summary>
+    /// Heating/cooling coupling of every zone to the indoor setpoint, in W/K per m³ of air
+    /// </summary>
+    public float HvacConductance { get; set; } = 10f;
+    
+    /// <summary>
+    /// Packs components and their layers into native arrays, replacing any previous contents.
+    /// Spaces (optional) become zone air nodes coupled to the components listed in their boundaries.
+    /// </summary>
+    public void Build(IEnumerable<BuildingComponent> source, float defaultInsideTemperature, IReadOnlyDictionary<string, BuildingOrganizer.SpaceData> spaces = null)
+    {
+        CompleteStep();
+        DisposeArrays();
+        components.Clear();
+        componentIndices.Clear();
+        zoneIds.Clear();
+        zoneIndices.Clear();
+        resultsPending = false;
+        this.defaultInsideTemperature = defaultInsideTemperature;
+        
+        foreach (var component in source)
+        {
+            if (component == null)
+                continue;
+            
+            componentIndices[component] = components.Count;
+            components.Add(component);
+        }
+        
+        int count = components.Count;
+        int totalLayers = 0;
+        foreach (var component in components)
+        {
+            totalLayers += CountLayers(component);
+        }
+        
+        layerStart = new NativeArray<int>(count, Allocator.Persistent);
+        layerCount = new NativeArray<int>(count, Allocator.Persistent);
+        nodeStart = new NativeArray<int>(count, Allocator.Persistent);
+        nodeCount = new NativeArray<int>(count, Allocator.Persistent);
+        conductance = new NativeArray<float>(count, Allocator.Persistent);
+        exteriorConductance = new NativeArray<float>(count, Allocator.Persistent);
+        insideTemperature = new NativeArray<float>(count, Allocator.Persistent);
+        outsideBoundaryTemperature = new NativeArray<float>(count, Allocator.Persistent);
+        insideZone = new NativeArray<int>(count, Allocator.Persistent);
+        outsideZone = new NativeArray<int>(count, Allocator.Persistent);
+        surfaceTemperature = new NativeArray<float>(count, Allocator.Persistent);
+        innerTemperature = new NativeArray<float>(count, Allocator.Persistent);
+        publishedSurfaceTemperature = new NativeArray<float>(count, Allocator.Persistent);
+        publishedInnerTemperature = new NativeArray<float>(count, Allocator.Persistent);
+        changed = new NativeArray<byte>(count, Allocator.Persistent);
+        stateIndex = new NativeArray<int>(count, Allocator.Persistent);
+        layerResistance = new NativeArray<float>(totalLayers, Allocator.Persistent);
+        layerThickness = new NativeArray<float>(totalLayers, Allocator.Persistent);
+        layerConductivity = new NativeArray<float>(totalLayers, Allocator.Persistent);
+        layerHeatCapacity = new NativeArray<float>(totalLayers, Allocator.Persistent);
+        layerNodeCount = new NativeArray<int>(totalLayers, Allocator.Persistent);
+        
+        int layerOffset = 0;
+        int nodeOffset = 0;
+        indexedStore = null;
+        for (int i = 0; i < count; i++)
+        {
+            BuildingComponent component = components[i];
+            int layers = WriteLayers(component, layerOffset);
+            
+            int nodes = 0;
+            for (int l = layerOffset; l < layerOffset + layers; l++)
+            {
+                nodes += layerNodeCount[l];
+            }
+            
+            layerStart[i] = layerOffset;
+            layerCount[i] = layers;
+            nodeStart[i] = nodeOffset;
+            nodeCount[i] = nodes;
+            layerOffset += layers;
+            nodeOffset += nodes;
+            
+            insideTemperature[i] = defaultInsideTemperature;
+            surfaceTemperature[i] = component.surfaceTemperature;
+            innerTemperature[i] = component.innerTemperature;
+            publishedSurfaceTemperature[i] = component.surfaceTemperature;
+            publishedInnerTemperature[i] = component.innerTemperature;
+        }
+        
+        nodeCapacity = new NativeArray<float>(nodeOffset, Allocator.Persistent);
+        nodeConductance = new NativeArray<float>(nodeOffset, Allocator.Persistent);
+        nodeTemperature = new NativeArray<float>(nodeOffset, Allocator.Persistent);
+        scratchUpper = new NativeArray<float>(nodeOffset, Allocator.Persistent);
+        scratchRhs = new NativeArray<float>(nodeOffset, Allocator.Persistent);
+        
+        // Start the wall profile as a linear blend from the exterior to the interior temperature
+        for (int i = 0; i < count; i++)
+        {
+            int start = nodeStart[i];
+            int nodes = nodeCount[i];
+            for (int j = 0; j < nodes; j++)
+            {
+                float t = nodes > 1 ? (float)j / (nodes - 1) : 0.5f;
+                nodeTemperature[start + j] = math.lerp(surfaceTemperature[i], innerTemperature[i], t);
+            }
+        }
+        
+        BuildZones(spaces);
+        
+        CreateSetupJob().Schedule(count, BatchSize).Complete();
+    }
+    
+    /// <summary>
+    /// Builds the zone graph from the spaces' boundary lists. A component belongs to at most two zones:
+    /// the first space listing it sees its interior face, a second space (internal boundaries only) its exterior face.
+    /// </summary>
+    private void BuildZones(IReadOnlyDictionary<string, BuildingOrganizer.SpaceData> spaces)
+    {
+        int count = components.Count;
+        for (int i = 0; i < count; i++)
+        {
+            insideZone[i] = -1;
+            outsideZone[i] = -1;
+        }
+        
+        var starts = new List<int>();
+        var boundaryComponents = new List<int>();
+        var boundaryConductances = new List<float>();
+        var boundarySides = new List<byte>();
+        var volumes = new List<float>();
+        
+        if (spaces != null && spaces.Count > 0)
+        {
+            // Build-time only lookups
+            var componentsById = new Dictionary<string, int>(count);
+            for (int i = 0; i < count; i++)
+            {
+                string globalId = components[i].globalId;
+                if (!string.IsNullOrEmpty(globalId))
+                    componentsById[globalId] = i;
+            }
+            
+            var boundaryArea = new float[count];
+            var externalBoundary = new bool[count];
+            
+            foreach (var entry in spaces)
+            {
+                BuildingOrganizer.SpaceData space = entry.Value;
+                if (space == null)
+                    continue;
+                
+                int zone = zoneIds.Count;
+                zoneIds.Add(entry.Key);
+                zoneIndices[entry.Key] = zone;
+                starts.Add(boundaryComponents.Count);
+                volumes.Add(GetSpaceVolume(space));
+                
+                foreach (var boundary in space.boundaries)
+                {
+                    if (boundary == null || string.IsNullOrEmpty(boundary.element_id) ||
+                        !componentsById.TryGetValue(boundary.element_id, out int component))
+                        continue;
+                    
+                    bool external = string.Equals(boundary.internal_external, "EXTERNAL", StringComparison.OrdinalIgnoreCase);
+                    
+                    byte side;
+                    if (insideZone[component] < 0)
+                    {
+                        insideZone[component] = zone;
+                        externalBoundary[component] = external;
+                        side = 0;
+                    }
+                    else if (insideZone[component] != zone && outsideZone[component] < 0 && !external && !externalBoundary[component])
+                    {
+                        outsideZone[component] = zone;
+                        side = 1;
+                    }
+                    else
+                    {
+                        continue; // Duplicate boundary, or a component already bounded on both sides
+                    }
+                    
+                    // One face of the component
+                    if (boundaryArea[component] <= 0f)
+                        boundaryArea[component] = components[component].GetFaceArea();
+                    
+                    boundaryComponents.Add(component);
+                    boundaryConductances.Add(boundaryArea[component] / InteriorSurfaceResistance);
+                    boundarySides.Add(side);
+                }
+            }
+        }
+        starts.Add(boundaryComponents.Count);
+        
+        zoneBoundaryStart = new NativeArray<int>(starts.ToArray(), Allocator.Persistent);
+        boundaryComponent = new NativeArray<int>(boundaryComponents.ToArray(), Allocator.Persistent);
+        boundaryConductance = new NativeArray<float>(boundaryConductances.ToArray(), Allocator.Persistent);
+        boundarySide = new NativeArray<byte>(boundarySides.ToArray(), Allocator.Persistent);
+        zoneVolume = new NativeArray<float>(volumes.ToArray(), Allocator.Persistent);
+        zoneTemperature = new NativeArray<float>(zoneIds.Count, Allocator.Persistent);
+        
+        for (int z = 0; z < zoneTemperature.Length; z++)
+        {
+            zoneTemperature[z] = defaultInsideTemperature;
+        }
+    }
+    
+    private static float GetSpaceVolume(BuildingOrganizer.SpaceData space)
+    {
+        if (space.properties != null)
+        {
+            foreach (string propertyName in volumePropertyNames)
+            {
+                if (space.properties.TryGetValue(propertyName, out string value) &&
+                    float.TryParse(value, System.Globalization.NumberStyles.Float, System.Globalization.CultureInfo.InvariantCulture, out float volume) &&
+                    volume > 0f)
+                    return volume;
+            }
+        }
+        return DefaultZoneVolume;
+    }
+    
+    /// <summary>
+    /// Re-reads a component's layers after a material change.
+    /// Returns false if the layer or node layout changed and the solver has to be rebuilt.
+    /// </summary>
+    public bool RefreshComponent(BuildingComponent component)
+    {
+        if (!componentIndices.TryGetValue(component, out int index))
+            return true; // Not packed, nothing to refresh
+        
+        if (CountLayers(component) != layerCount[index])
+            return false;
+        
+        CompleteStep();
+        
+        int start = layerStart[index];
+        WriteLayers(component, start);
+        
+        int nodes = 0;
+        for (int l = start; l < start + layerCount[index]; l++)
+        {
+            nodes += layerNodeCount[l];
+        }
+        if (nodes != nodeCount[index])
+            return false;
+        
+        // Recompute this component's conductances and node properties in place
+        CreateSetupJob().Execute(index);
+        return true;
+    }
+    
+    /// <summary>
+    /// Sets the indoor temperature: the interior air of components outside any zone, and the setpoint of every zone
+    /// </summary>
+    public void SetInsideTemperature(float temperature)
+    {
+        CompleteStep();
+        defaultInsideTemperature = temperature;
+    }
+    
+    /// <summary>
+    /// Space GlobalId of a zone
+    /// </summary>
+    public string GetZoneId(int zone)
+    {
+        return zoneIds[zone];
+    }
+    
+    /// <summary>
+    /// Air temperature of a zone as of the last completed step
+    /// </summary>
+    public float GetZoneTemperature(int zone)
+    {
+        CompleteStep();
+        return zoneTemperature[zone];
+    }
+    
+    public bool TryGetZoneIndex(string spaceId, out int zone)
+    {
+        return zoneIndices.TryGetValue(spaceId, out zone);
+    }
+    
+    /// <summary>
+    /// Schedules one solver step. Call CompleteAndApply later in the frame to collect the results.
+    /// </summary>
+    public void ScheduleStep(ThermalModel model, float outsideTemperature, float timeStep, float changeThreshold)
+    {
+        if (!IsCreated || components.Count == 0 || timeStep <= 0f)
+            return;
+        
+        // Results of a step that was never collected would be overwritten by this one
+        CompleteAndApply();
+        
+        // Air temperatures on both sides of every component, from the zones as of the previous step
+        var boundaryJob = new ComponentBoundaryJob
+        {
+            insideZone = insideZone,
+            outsideZone = outsideZone,
+            zoneTemperature = zoneTemperature,
+            defaultInsideTemperature = defaultInsideTemperature,
+            outsideTemperature = outsideTemperature,
+            insideTemperature = insideTemperature,
+            outsideBoundaryTemperature = outsideBoundaryTemperature
+        };
+        JobHandle boundaryHandle = boundaryJob.Schedule(components.Count, BatchSize);
+        
+        if (model == ThermalModel.Layered)
+        {
+            var job = new LayeredStepJob
+            {
+                nodeStart = nodeStart,
+                nodeCount = nodeCount,
+                outsideZone = outsideZone,
+                exteriorConductance = exteriorConductance,
+                insideTemperature = insideTemperature,
+                outsideTemperature = outsideBoundaryTemperature,
+                nodeCapacity = nodeCapacity,
+                nodeConductance = nodeConductance,
+                timeStep = timeStep,
+                changeThreshold = changeThreshold,
+                nodeTemperature = nodeTemperature,
+                scratchUpper = scratchUpper,
+                scratchRhs = scratchRhs,
+                surfaceTemperature = surfaceTemperature,
+                innerTemperature = innerTemperature,
+                publishedSurfaceTemperature = publishedSurfaceTemperature,
+                publishedInnerTemperature = publishedInnerTemperature,
+                changed = changed
+            };
+            stepHandle = job.Schedule(components.Count, BatchSize, boundaryHandle);
+        }
+        else
+        {
+            var job = new LumpedStepJob
+            {
+                conductance = conductance,
+                insideTemperature = insideTemperature,
+                outsideTemperature = outsideBoundaryTemperature,
+                timeStep = timeStep,
+                changeThreshold = changeThreshold,
+                surfaceTemperature = surfaceTemperature,
+                innerTemperature = innerTemperature,
+                publishedSurfaceTemperature = publishedSurfaceTemperature,
+                publishedInnerTemperature = publishedInnerTemperature,
+                changed = changed
+            };
+            stepHandle = job.Schedule(components.Count, BatchSize, boundaryHandle);
+        }
+        
+        // Zone air balances against the new surface temperatures
+        if (zoneIds.Count > 0)
+        {
+            var zoneJob = new ZoneAirStepJob
+            {
+                zoneBoundaryStart = zoneBoundaryStart,
+                boundaryComponent = boundaryComponent,
+                boundaryConductance = boundaryConductance,
+                boundarySide = boundarySide,
+                zoneVolume = zoneVolume,
+                surfaceTemperature = surfaceTemperature,
+                innerTemperature = innerTemperature,
+                outsideTemperature = outsideTemperature,
+                setpointTemperature = defaultInsideTemperature,
+                airChangesPerHour = AirChangesPerHour,
+                hvacConductance = HvacConductance,
+                timeStep = timeStep,
+                zoneTemperature = zoneTemperature
+            };
+            stepHandle = zoneJob.Schedule(zoneIds.Count, ZoneBatchSize, stepHandle);
+        }
+        
+        stepScheduled = true;
+        resultsPending = true;
+    }
+    
+    /// <summary>
+    /// Waits for the scheduled step and copies changed temperatures back to the components,
+    /// or scatters them into the state store the components are registered with.
+    /// Returns the number of components updated.
+    /// </summary>
+    public int CompleteAndApply(ComponentStateStore store = null)
+    {
+        if (!resultsPending)
+            return 0;
+        
+        CompleteStep();
+        resultsPending = false;
+        
+        if (store != null && store.IsCreated)
+        {
+            RefreshStateIndices(store);
+        }
+        
+        if (store != null && store.IsCreated && allComponentsInStore)
+        {
+            NativeArray<int> updatedCount = new NativeArray<int>(1, Allocator.TempJob);
+            new StateScatterJob
+            {
+                stateIndex = stateIndex,
+                changed = changed,
+                surfaceTemperature = surfaceTemperature,
+                innerTemperature = innerTemperature,
+                storeSurfaceTemperature = store.SurfaceTemperature,
+                storeInnerTemperature = store.InnerTemperature,
+                updatedCount = updatedCount
+            }.Run();
+            
+            int scattered = updatedCount[0];
+            updatedCount.Dispose();
+            return scattered;
+        }
+        
+        int updated = 0;
+        for (int i = 0; i < components.Count; i++)
+        {
+            if (changed[i] == 0)
+                continue;
+            
+            BuildingComponent component = components[i];
+            if (component == null)
+                continue;
+            
+            component.surfaceTemperature = surfaceTemperature[i];
+            component.innerTemperature = innerTemperature[i];
+            updated++;
+        }
+        
+        return updated;
+    }
+    
+    /// <summary>
+    /// Re-reads the components' store slots if the store changed since they were last read,
+    /// as released slots are reused by later registrations
+    /// </summary>
+    private void RefreshStateIndices(ComponentStateStore store)
+    {
+        if (store == indexedStore && store.Version == indexedStoreVersion)
+            return;
+        
+        allComponentsInStore = true;
+        for (int i = 0; i < components.Count; i++)
+        {
+            BuildingComponent component = components[i];
+            bool inStore = component != null && component.StateStore == store;
+            stateIndex[i] = inStore ? component.StateIndex : -1;
+            allComponentsInStore &= inStore;
+        }
+        
+        indexedStore = store;
+        indexedStoreVersion = store.Version;
+    }
+    
+    public void Dispose()
+    {
+        CompleteStep();
+        DisposeArrays();
+        components.Clear();
+        componentIndices.Clear();
+        zoneIds.Clear();
+        zoneIndices.Clear();
+    }
+    
+    private void CompleteStep()
+    {
+        if (stepScheduled)
+        {
+            stepHandle.Complete();
+            stepScheduled = false;
+        }
+    }
+    
+    private void DisposeArrays()
+    {
+        if (layerStart.IsCreated) layerStart.Dispose();
+        if (layerCount.IsCreated) layerCount.Dispose();
+        if (nodeStart.IsCreated) nodeStart.Dispose();
+        if (nodeCount.IsCreated) nodeCount.Dispose();
+        if (conductance.IsCreated) conductance.Dispose();
+        if (exteriorConductance.IsCreated) exteriorConductance.Dispose();
+        if (insideTemperature.IsCreated) insideTemperature.Dispose();
+        if (outsideBoundaryTemperature.IsCreated) outsideBoundaryTemperature.Dispose();
+        if (insideZone.IsCreated) insideZone.Dispose();
+        if (outsideZone.IsCreated) outsideZone.Dispose();
+        if (surfaceTemperature.IsCreated) surfaceTemperature.Dispose();
+        if (innerTemperature.IsCreated) innerTemperature.Dispose();
+        if (publishedSurfaceTemperature.IsCreated) publishedSurfaceTemperature.Dispose();
+        if (publishedInnerTemperature.IsCreated) publishedInnerTemperature.Dispose();
+        if (changed.IsCreated) changed.Dispose();
+        if (stateIndex.IsCreated) stateIndex.Dispose();
+        if (layerResistance.IsCreated) layerResistance.Dispose();
+        if (layerThickness.IsCreated) layerThickness.Dispose();
+        if (layerConductivity.IsCreated) layerConductivity.Dispose();
+        if (layerHeatCapacity.IsCreated) layerHeatCapacity.Dispose();
+        if (layerNodeCount.IsCreated) layerNodeCount.Dispose();
+        if (nodeCapacity.IsCreated) nodeCapacity.Dispose();
+        if (nodeConductance.IsCreated) nodeConductance.Dispose();
+        if (nodeTemperature.IsCreated) nodeTemperature.Dispose();
+        if (scratchUpper.IsCreated) scratchUpper.Dispose();
+        if (scratchRhs.IsCreated) scratchRhs.Dispose();
+        if (zoneBoundaryStart.IsCreated) zoneBoundaryStart.Dispose();
+        if (boundaryComponent.IsCreated) boundaryComponent.Dispose();
+        if (boundaryConductance.IsCreated) boundaryConductance.Dispose();
+        if (boundarySide.IsCreated) boundarySide.Dispose();
+        if (zoneVolume.IsCreated) zoneVolume.Dispose();
+        if (zoneTemperature.IsCreated) zoneTemperature.Dispose();
+    }
+    
+    private ComponentSetupJob CreateSetupJob()
+    {
+        return new ComponentSetupJob
+        {
+            layerStart = layerStart,
+            layerCount = layerCount,
+            nodeStart = nodeStart,
+            outsideZone = outsideZone,
+            layerResistance = layerResistance,
+            layerThickness = layerThickness,
+            layerConductivity = layerConductivity,
+            layerHeatCapacity = layerHeatCapacity,
+            layerNodeCount = layerNodeCount,
+            conductance = conductance,
+            exteriorConductance = exteriorConductance,
+            nodeCapacity = nodeCapacity,
+            nodeConductance = nodeConductance
+        };
+    }
+    
+    /// <summary>
+    /// Number of layers packed for a component. Single-material components count as one layer,
+    /// and components without any material get one stand-in layer.
+    /// </summary>
+    private static int CountLayers(BuildingComponent component)
+    {
+        if (!component.isMultiLayer)
+            return 1;
+        
+        int count = 0;
+        foreach (var layer in component.materialLayers)
+        {
+            if (layer.material != null)
+                count++;
+        }
+        return math.max(count, 1);
+    }
+    
+    /// <summary>
+    /// Writes a component's layers starting at offset, mirroring BuildingComponent.GetUValue
+    /// (layers without a material are skipped). Returns the number of layers written.
+    /// </summary>
+    private int WriteLayers(BuildingComponent component, int offset)
+    {
+        if (!component.isMultiLayer)
+        {
+            if (component.currentMaterial == null)
+            {
+                WriteDefaultLayer(offset, component.componentThickness);
+                return 1;
+            }
+            
+            WriteLayer(offset, component.currentMaterial, component.componentThickness);
+            return 1;
+        }
+        
+        int written = 0;
+        foreach (var layer in component.materialLayers)
+        {
+            if (layer.material == null)
+                continue;
+            
+            WriteLayer(offset + written, layer.material, layer.thickness);
+            written++;
+        }
+        
+        if (written == 0)
+        {
+            WriteDefaultLayer(offset, component.GetTotalThickness());
+            written = 1;
+        }
+        return written;
+    }
+    
+    private void WriteLayer(int index, BuildingPhysicsMaterial material, float thickness)
+    {
+        // The resistance (and so the lumped U-value) uses the real thickness, as GetUValue does;
+        // only the layered model's node geometry is clamped, so sub-centimetre layers still get a node
+        layerResistance[index] = material.GetThermalResistance(thickness);
+        thickness = math.max(thickness, MinimumThickness);
+        layerThickness[index] = thickness;
+        layerConductivity[index] = math.max(material.thermalConductivity, 0.001f);
+        layerHeatCapacity[index] = material.GetThermalMass(1.0f, 1.0f); // Per m³
+        layerNodeCount[index] = NodesForThickness(thickness);
+    }
+        
+    private void WriteDefaultLayer(int index, float thickness)
+    {
+        thickness = math.max(thickness, MinimumThickness);
+        layerResistance[index] = 1.0f;
+        layerThickness[index] = thickness;
+        layerConductivity[index] = thickness; // R = thickness / conductivity = 1
+        layerHeatCapacity[index] = DefaultVolumetricHeatCapacity;
+        layerNodeCount[index] = NodesForThickness(thickness);
+    }
+    
+    private static int NodesForThickness(float thickness)
+    {
+        return math.clamp((int)math.ceil(thickness / TargetNodeSpacing), 1, MaxNodesPerLayer);
+    }
+    
+    /// <summary>
+    /// Derives per-component U-values and per-node capacities/conductances from the packed layers.
+    /// Nodes sit at the centres of equal slices of each layer.
+    /// </summary>
+    [BurstCompile]
+    private struct ComponentSetupJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<int> layerStart;
+        [ReadOnly] public NativeArray<int> layerCount;
+        [ReadOnly] public NativeArray<int> nodeStart;
+        [ReadOnly] public NativeArray<int> outsideZone;
+        [ReadOnly] public NativeArray<float> layerResistance;
+        [ReadOnly] public NativeArray<float> layerThickness;
+        [ReadOnly] public NativeArray<float> layerConductivity;
+        [ReadOnly] public NativeArray<float> layerHeatCapacity;
+        [ReadOnly] public NativeArray<int> layerNodeCount;
+        
+        public NativeArray<float> conductance;
+        public NativeArray<float> exteriorConductance;
+        [NativeDisableParallelForRestriction] public NativeArray<float> nodeCapacity;
+        [NativeDisableParallelForRestriction] public NativeArray<float> nodeConductance;
+        
+        public void Execute(int i)
+        {
+            int firstLayer = layerStart[i];
+            int lastLayer = firstLayer + layerCount[i];
+            int firstNode = nodeStart[i];
+            
+            float totalResistance = 0f;
+            int node = firstNode;
+            float previousHalfResistance = 0f;
+            
+            for (int l = firstLayer; l < lastLayer; l++)
+            {
+                totalResistance += layerResistance[l];
+                
+                int slices = layerNodeCount[l];
+                float dx = layerThickness[l] / slices;
+                float halfResistance = dx / (2f * layerConductivity[l]);
+                float capacity = layerHeatCapacity[l] * dx;
+                
+                for (int s = 0; s < slices; s++)
+                {
+                    if (node == firstNode)
+                    {
+                        exteriorConductance[i] = 1f / (ExteriorFilmResistance(outsideZone[i]) + halfResistance);
+                    }
+                    else
+                    {
+                        nodeConductance[node - 1] = 1f / (previousHalfResistance + halfResistance);
+                    }
+                    
+                    nodeCapacity[node] = capacity;
+                    previousHalfResistance = halfResistance;
+                    node++;
+                }
+            }
+            
+            // Last node couples to the interior air
+            nodeConductance[node - 1] = 1f / (previousHalfResistance + InteriorSurfaceResistance);
+            
+            // Default for unknown materials, as in BuildingComponent.GetUValue. A zero-thickness single
+            // material is the one case that differs: GetUValue returns infinity there (clamped to 100 by the step)
+            conductance[i] = totalResistance > 0f ? 1.0f / totalResistance : 1.0f;
+        }
+    }
+    
+    /// <summary>
+    /// Lumped model identical to BuildingComponent.UpdateTemperature, applied to every component at once
+    /// </summary>
+    [BurstCompile]
+    private struct LumpedStepJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<float> conductance;
+        [ReadOnly] public NativeArray<float> insideTemperature;
+        [ReadOnly] public NativeArray<float> outsideTemperature;
+        public float timeStep;
+        public float changeThreshold;
+        
+        public NativeArray<float> surfaceTemperature;
+        public NativeArray<float> innerTemperature;
+        public NativeArray<float> publishedSurfaceTemperature;
+        public NativeArray<float> publishedInnerTemperature;
+        [WriteOnly] public NativeArray<byte> changed;
+        
+        public void Execute(int i)
+        {
+            float resistance = 1.0f / conductance[i];
+            float k = 1.0f / math.max(resistance, 0.01f);
+            float inside = insideTemperature[i];
+            float outside = outsideTemperature[i];
+            
+            // Surface temperature moves toward equilibrium between inside and outside
+            float surface = math.lerp(surfaceTemperature[i], (outside + inside) * 0.5f, math.saturate(k * timeStep * 0.1f));
+            
+            // Interior temperature changes more slowly, weighted toward inside
+            float inner = math.lerp(innerTemperature[i], (outside + inside * 3.0f) * 0.25f, math.saturate(k * 0.05f * timeStep));
+            
+            surfaceTemperature[i] = surface;
+            innerTemperature[i] = inner;
+            changed[i] = Publish(i, surface, inner, changeThreshold, publishedSurfaceTemperature, publishedInnerTemperature);
+        }
+    }
+    
+    /// <summary>
+    /// Implicit (backward Euler) 1D conduction through the layer nodes of every component.
+    /// Each component's tridiagonal system is solved with the Thomas algorithm; in layered mode
+    /// surfaceTemperature is the exterior surface and innerTemperature the interior surface.
+    /// </summary>
+    [BurstCompile]
+    private struct LayeredStepJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<int> nodeStart;
+        [ReadOnly] public NativeArray<int> nodeCount;
+        [ReadOnly] public NativeArray<int> outsideZone;
+        [ReadOnly] public NativeArray<float> exteriorConductance;
+        [ReadOnly] public NativeArray<float> insideTemperature;
+        [ReadOnly] public NativeArray<float> outsideTemperature;
+        [ReadOnly, NativeDisableParallelForRestriction] public NativeArray<float> nodeCapacity;
+        [ReadOnly, NativeDisableParallelForRestriction] public NativeArray<float> nodeConductance;
+        public float timeStep;
+        public float changeThreshold;
+        
+        // Each component only touches its own node range
+        [NativeDisableParallelForRestriction] public NativeArray<float> nodeTemperature;
+        [NativeDisableParallelForRestriction] public NativeArray<float> scratchUpper;
+        [NativeDisableParallelForRestriction] public NativeArray<float> scratchRhs;
+        
+        public NativeArray<float> surfaceTemperature;
+        public NativeArray<float> innerTemperature;
+        public NativeArray<float> publishedSurfaceTemperature;
+        public NativeArray<float> publishedInnerTemperature;
+        [WriteOnly] public NativeArray<byte> changed;
+        
+        public void Execute(int i)
+        {
+            int start = nodeStart[i];
+            int last = start + nodeCount[i] - 1;
+            float inside = insideTemperature[i];
+            float outside = outsideTemperature[i];
+            float inverseTimeStep = 1f / timeStep;
+            
+            // Forward sweep
+            float previousConductance = exteriorConductance[i];
+            for (int n = start; n <= last; n++)
+            {
+                float storage = nodeCapacity[n] * inverseTimeStep;
+                float nextConductance = nodeConductance[n];
+                
+                float lower = n == start ? 0f : -previousConductance;
+                float upper = n == last ? 0f : -nextConductance;
+                float diagonal = storage + previousConductance + nextConductance;
+                float rhs = storage * nodeTemperature[n];
+                
+                // Boundary air temperatures are known and move to the right-hand side
+                if (n == start) rhs += previousConductance * outside;
+                if (n == last) rhs += nextConductance * inside;
+                
+                if (n > start)
+                {
+                    diagonal -= lower * scratchUpper[n - 1];
+                    rhs -= lower * scratchRhs[n - 1];
+                }
+                
+                scratchUpper[n] = upper / diagonal;
+                scratchRhs[n] = rhs / diagonal;
+                previousConductance = nextConductance;
+            }
+            
+            // Back substitution
+            nodeTemperature[last] = scratchRhs[last];
+            for (int n = last - 1; n >= start; n--)
+            {
+                nodeTemperature[n] = scratchRhs[n] - scratchUpper[n] * nodeTemperature[n + 1];
+            }
+            
+            // Surface temperatures from the heat flux through the surface films
+            float exteriorFlux = exteriorConductance[i] * (outside - nodeTemperature[start]);
+            float interiorFlux = nodeConductance[last] * (nodeTemperature[last] - inside);
+            float surface = outside - exteriorFlux * ExteriorFilmResistance(outsideZone[i]);
+            float inner = inside + interiorFlux * InteriorSurfaceResistance;
+            
+            surfaceTemperature[i] = surface;
+            innerTemperature[i] = inner;
+            changed[i] = Publish(i, surface, inner, changeThreshold, publishedSurfaceTemperature, publishedInnerTemperature);
+        }
+    }
+    
+    /// <summary>
+    /// Reads the air temperatures on both sides of every component from its zones
+    /// </summary>
+    [BurstCompile]
+    private struct ComponentBoundaryJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<int> insideZone;
+        [ReadOnly] public NativeArray<int> outsideZone;
+        [ReadOnly] public NativeArray<float> zoneTemperature;
+        public float defaultInsideTemperature;
+        public float outsideTemperature;
+        
+        [WriteOnly] public NativeArray<float> insideTemperature;
+        [WriteOnly] public NativeArray<float> outsideBoundaryTemperature;
+        
+        public void Execute(int i)
+        {
+            int inside = insideZone[i];
+            int outside = outsideZone[i];
+            insideTemperature[i] = inside >= 0 ? zoneTemperature[inside] : defaultInsideTemperature;
+            outsideBoundaryTemperature[i] = outside >= 0 ? zoneTemperature[outside] : outsideTemperature;
+        }
+    }
+    
+    /// <summary>
+    /// Implicit air balance of every zone: convection from its boundary surfaces, outdoor air exchange
+    /// and a proportional heating/cooling term toward the setpoint
+    /// </summary>
+    [BurstCompile]
+    private struct ZoneAirStepJob : IJobParallelFor
+    {
+        [ReadOnly] public NativeArray<int> zoneBoundaryStart;
+        [ReadOnly] public NativeArray<int> boundaryComponent;
+        [ReadOnly] public NativeArray<float> boundaryConductance;
+        [ReadOnly] public NativeArray<byte> boundarySide;
+        [ReadOnly] public NativeArray<float> zoneVolume;
+        [ReadOnly] public NativeArray<float> surfaceTemperature;
+        [ReadOnly] public NativeArray<float> innerTemperature;
+        public float outsideTemperature;
+        public float setpointTemperature;
+        public float airChangesPerHour;
+        public float hvacConductance;
+        public float timeStep;
+        
+        public NativeArray<float> zoneTemperature;
+        
+        public void Execute(int z)
+        {
+            float volume = zoneVolume[z];
+            float storage = volume * AirVolumetricHeatCapacity / timeStep;
+            float infiltration = airChangesPerHour * volume * AirVolumetricHeatCapacity / 3600f;
+            float hvac = hvacConductance * volume;
+            
+            float diagonal = storage + infiltration + hvac;
+            float rhs = storage * zoneTemperature[z] + infiltration * outsideTemperature + hvac * setpointTemperature;
+            
+            int end = zoneBoundaryStart[z + 1];
+            for (int b = zoneBoundaryStart[z]; b < end; b++)
+            {
+                int component = boundaryComponent[b];
+                float surface = boundarySide[b] == 0 ? innerTemperature[component] : surfaceTemperature[component];
+                diagonal += boundaryConductance[b];
+                rhs += boundaryConductance[b] * surface;
+            }
+            
+            zoneTemperature[z] = rhs / diagonal;
+        }
+    }
+    
+    /// <summary>
+    /// Exterior faces bordering another zone use the interior film resistance
+    /// </summary>
+    private static float ExteriorFilmResistance(int outsideZone)
+    {
+        return outsideZone >= 0 ? InteriorSurfaceResistance : ExteriorSurfaceResistance;
+    }
+    
+    /// <summary>
+    /// Marks a component for copy-back when either temperature moved past the threshold since it was last published
+    /// </summary>
+    private static byte Publish(int i, float surface, float inner, float threshold, NativeArray<float> publishedSurface, NativeArray<float> publishedInner)
+    {
+        bool moved = math.abs(surface - publishedSurface[i]) > threshold ||
+                     math.abs(inner - publishedInner[i]) > threshold;
+        if (!moved)
+            return 0;
+        
+        publishedSurface[i] = surface;
+        publishedInner[i] = inner;
+        return 1;
+    }
+    
+    /// <summary>
+    /// Writes changed component temperatures into their ComponentStateStore slots
+    /// </summary>
+    [BurstCompile]
+    private struct StateScatterJob : IJob
+    {
+        [ReadOnly] public NativeArray<int> stateIndex;
+        [ReadOnly] public NativeArray<byte> changed;
+        [ReadOnly] public NativeArray<float> surfaceTemperature;
+        [ReadOnly] public NativeArray<float> innerTemperature;
+        
+        public NativeArray<float> storeSurfaceTemperature;
+        public NativeArray<float> storeInnerTemperature;
+        public NativeArray<int> updatedCount;
+        
+        public void Execute()
+        {
+            int updated = 0;
+            for (int i = 0; i < stateIndex.Length; i++)
+            {
+                if (changed[i] == 0)
+                    continue;
+                
+                int slot = stateIndex[i];
+                storeSurfaceTemperature[slot] = surfaceTemperature[i];
+                storeInnerTemperature[slot] = innerTemperature[i];
+                updated++;
+            }
+            updatedCount[0] = updated;
+        }
+    }
+}
\ No newline at end of file
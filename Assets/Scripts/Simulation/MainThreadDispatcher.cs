@@ -0,0 +1,256 @@
+using UnityEngine;
+using System;
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Threading;
+
+/// <summary>
+/// Runs callbacks queued from background threads on the main thread.
+/// Work items are structs in a bounded lock-free ring (multiple producers, the main thread as the only
+/// consumer), so producers never wait on a running callback. Callbacks that take a state object avoid
+/// allocating a closure per call. Each frame runs queued work until FrameBudgetMilliseconds is used up;
+/// the rest carries over to the next frame. Items that do not fit into the ring go to an unbounded
+/// overflow queue, and so does everything enqueued after them until that queue has drained, so items
+/// from one producer always run in the order they were enqueued.
+/// </summary>
+public class MainThreadDispatcher : MonoBehaviour
+{
+    public const int Capacity = 4096; // Power of two
+    
+    private struct WorkItem
+    {
+        public Action action;
+        public Action<object> callback;
+        public object state;
+        public long enqueuedTimestamp; // Stopwatch ticks
+        
+        public void Invoke()
+        {
+            if (action != null)
+            {
+                action();
+            }
+            else
+            {
+                callback(state);
+            }
+        }
+    }
+    
+    // Ring slots; sequence[i] tells producers and the consumer whose turn slot i is
+    private static WorkItem[] items = new WorkItem[Capacity];
+    private static long[] sequence = CreateSequence();
+    private static long enqueuePosition;
+    private static long dequeuePosition; // Main thread only
+    private static ConcurrentQueue<WorkItem> overflow = new ConcurrentQueue<WorkItem>();
+    private static long overflowPending; // Items in (or being added to) overflow
+    
+    // Counters
+    private static long enqueuedCount;
+    private static long executedCount;
+    private static long overflowCount;
+    private static int lastFrameExecuted;
+    private static double lastFrameMaxLatency;
+    private static double averageLatency;
+    
+    private static MainThreadDispatcher instance;
+    
+    /// <summary>
+    /// Main thread time spent on queued work per frame; at least one item runs every frame
+    /// </summary>
+    public static float FrameBudgetMilliseconds { get; set; } = 2.0f;
+    
+    /// <summary>
+    /// Items waiting to run, including overflow
+    /// </summary>
+    public static int QueueDepth => (int)Math.Max(0, Interlocked.Read(ref enqueuedCount) - Interlocked.Read(ref executedCount));
+    public static long ExecutedCount => Interlocked.Read(ref executedCount);
+    public static long OverflowCount => Interlocked.Read(ref overflowCount);
+    public static int LastFrameExecuted => lastFrameExecuted;
+    
+    /// <summary>
+    /// Longest time an item executed in the last frame waited in the queue, in milliseconds
+    /// </summary>
+    public static double LastFrameMaxLatencyMilliseconds => lastFrameMaxLatency;
+    
+    /// <summary>
+    /// Moving average of the time items wait in the queue, in milliseconds
+    /// </summary>
+    public static double AverageLatencyMilliseconds => averageLatency;
+    
+    [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.SubsystemRegistration)]
+    private static void ResetStatics()
+    {
+        // Play mode can start without a domain reload
+        items = new WorkItem[Capacity];
+        sequence = CreateSequence();
+        enqueuePosition = 0;
+        dequeuePosition = 0;
+        overflow = new ConcurrentQueue<WorkItem>();
+        overflowPending = 0;
+        enqueuedCount = 0;
+        executedCount = 0;
+        overflowCount = 0;
+        lastFrameExecuted = 0;
+        lastFrameMaxLatency = 0;
+        averageLatency = 0;
+        instance = null;
+    }
+    
+    [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.BeforeSceneLoad)]
+    private static void CreateInstance()
+    {
+        // Created up front on the main thread, since Enqueue is called from background threads
+        if (instance == null)
+        {
+            GameObject dispatcherObject = new GameObject("MainThreadDispatcher");
+            instance = dispatcherObject.AddComponent<MainThreadDispatcher>();
+        }
+    }
+    
+    void Awake()
+    {
+        if (instance == null || instance == this)
+        {
+            instance = this;
+            DontDestroyOnLoad(gameObject);
+        }
+        else
+        {
+            Destroy(gameObject);
+        }
+    }
+    
+    void Update()
+    {
+        long start = Stopwatch.GetTimestamp();
+        long budget = (long)(FrameBudgetMilliseconds * Stopwatch.Frequency / 1000.0);
+        int executed = 0;
+        double maxLatency = 0;
+        
+        while (TryDequeue(out WorkItem item))
+        {
+            long now = Stopwatch.GetTimestamp();
+            double latency = (now - item.enqueuedTimestamp) * 1000.0 / Stopwatch.Frequency;
+            maxLatency = Math.Max(maxLatency, latency);
+            averageLatency += (latency - averageLatency) * 0.05;
+            
+            try
+            {
+                item.Invoke();
+            }
+            catch (Exception e)
+            {
+                UnityEngine.Debug.LogException(e);
+            }
+            
+            executed++;
+            Interlocked.Increment(ref executedCount);
+            
+            if (Stopwatch.GetTimestamp() - start >= budget)
+                break;
+        }
+        
+        lastFrameExecuted = executed;
+        lastFrameMaxLatency = maxLatency;
+    }
+    
+    /// <summary>
+    /// Enqueues an action to be executed on the main thread.
+    /// Pass a cached delegate to keep the call allocation-free.
+    /// </summary>
+    public static void Enqueue(Action action)
+    {
+        Enqueue(new WorkItem { action = action });
+    }
+    
+    /// <summary>
+    /// Enqueues callback(state) to be executed on the main thread, without capturing a closure
+    /// </summary>
+    public static void Enqueue(Action<object> callback, object state)
+    {
+        Enqueue(new WorkItem { callback = callback, state = state });
+    }
+    
+    private static void Enqueue(WorkItem item)
+    {
+        if (item.action == null && item.callback == null)
+            return;
+        
+        item.enqueuedTimestamp = Stopwatch.GetTimestamp();
+        Interlocked.Increment(ref enqueuedCount);
+        
+        // While older items wait in overflow, newer ones must not overtake them through freed ring slots
+        if (Interlocked.Read(ref overflowPending) > 0 || !TryEnqueue(item))
+        {
+            Interlocked.Increment(ref overflowCount);
+            Interlocked.Increment(ref overflowPending);
+            overflow.Enqueue(item);
+        }
+    }
+    
+    private static bool TryEnqueue(in WorkItem item)
+    {
+        WorkItem[] ring = items;
+        long[] turns = sequence;
+        long position = Interlocked.Read(ref enqueuePosition);
+        
+        while (true)
+        {
+            int slot = (int)(position & (Capacity - 1));
+            long difference = Volatile.Read(ref turns[slot]) - position;
+            
+            if (difference == 0)
+            {
+                // Slot is free for this position; claim it
+                long observed = Interlocked.CompareExchange(ref enqueuePosition, position + 1, position);
+                if (observed == position)
+                {
+                    ring[slot] = item;
+                    Volatile.Write(ref turns[slot], position + 1);
+                    return true;
+                }
+                position = observed;
+            }
+            else if (difference < 0)
+            {
+                // The consumer has not freed this slot yet: the ring is full
+                return false;
+            }
+            else
+            {
+                position = Interlocked.Read(ref enqueuePosition);
+            }
+        }
+    }
+    
+    private static bool TryDequeue(out WorkItem item)
+    {
+        int slot = (int)(dequeuePosition & (Capacity - 1));
+        if (Volatile.Read(ref sequence[slot]) == dequeuePosition + 1)
+        {
+            item = items[slot];
+            items[slot] = default; // Release references held by the item
+            Volatile.Write(ref sequence[slot], dequeuePosition + Capacity);
+            dequeuePosition++;
+            return true;
+        }
+        
+        // The ring only holds items older than the overflow's, so overflow runs once the ring is empty
+        if (!overflow.TryDequeue(out item))
+            return false;
+        
+        Interlocked.Decrement(ref overflowPending);
+        return true;
+    }
+    
+    private static long[] CreateSequence()
+    {
+        long[] turns = new long[Capacity];
+        for (int i = 0; i < Capacity; i++)
+        {
+            turns[i] = i;
+        }
+        return turns;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+using System;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.IO;
+using System.Threading;
+
+/// <summary>
+/// Reassembles complete frames from a blocking stream (see MessageFraming).
+/// Bytes are read into one pooled buffer that only grows for frames larger than it, and each frame is
+/// returned as a segment of that buffer, valid until the next ReadFrame call. Not thread-safe; one reader per thread.
+/// </summary>
+public class MessageFrameReader : IDisposable
+{
+    private const int InitialBufferSize = 64 * 1024;
+    
+    private readonly Stream stream;
+    private readonly MessageFraming framing;
+    private readonly int maxFrameLength;
+    
+    private byte[] buffer;
+    private int start;      // First unconsumed byte
+    private int end;        // One past the last received byte
+    private int scanned;    // Newline mode: bytes after start already searched for a delimiter
+    
+    public MessageFrameReader(Stream stream, MessageFraming framing, int maxFrameLength)
+    {
+        this.stream = stream;
+        this.framing = framing;
+        this.maxFrameLength = maxFrameLength;
+        buffer = ArrayPool<byte>.Shared.Rent(Math.Min(InitialBufferSize, maxFrameLength + MessageFrame.LengthPrefixSize));
+    }
+    
+    /// <summary>
+    /// Blocks until a complete frame has been received. Returns false when the stream ended or the token was cancelled.
+    /// Throws InvalidDataException for frames larger than maxFrameLength.
+    /// </summary>
+    public bool ReadFrame(CancellationToken cancellationToken, out ArraySegment<byte> frame)
+    {
+        while (!cancellationToken.IsCancellationRequested)
+        {
+            if (TryTakeFrame(out frame))
+                return true;
+            
+            if (!Fill())
+                break;
+        }
+        
+        frame = default;
+        return false;
+    }
+    
+    public void Dispose()
+    {
+        if (buffer != null)
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+            buffer = null;
+        }
+    }
+    
+    private bool TryTakeFrame(out ArraySegment<byte> frame)
+    {
+        int available = end - start;
+        
+        if (framing == MessageFraming.LengthPrefixed)
+        {
+            if (available >= MessageFrame.LengthPrefixSize)
+            {
+                int length = BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(buffer, start, MessageFrame.LengthPrefixSize));
+                if (length < 0 || length > maxFrameLength)
+                    throw new InvalidDataException($"Invalid frame length {length}");
+                
+                if (available >= MessageFrame.LengthPrefixSize + length)
+                {
+                    frame = new ArraySegment<byte>(buffer, start + MessageFrame.LengthPrefixSize, length);
+                    start += MessageFrame.LengthPrefixSize + length;
+                    return true;
+                }
+                
+                EnsureCapacity(MessageFrame.LengthPrefixSize + length);
+            }
+        }
+        else if (framing == MessageFraming.Unframed)
+        {
+            // Whatever one read returned is one message, as the server sends each message in one write
+            if (available > 0)
+            {
+                frame = new ArraySegment<byte>(buffer, start, available);
+                start = 0;
+                end = 0;
+                return true;
+            }
+        }
+        else
+        {
+            int delimiter = Array.IndexOf(buffer, MessageFrame.Delimiter, start + scanned, available - scanned);
+            if (delimiter >= 0)
+            {
+                int length = delimiter - start;
+                
+                // Tolerate CRLF line endings
+                if (length > 0 && buffer[delimiter - 1] == (byte)'\r')
+                    length--;
+                
+                frame = new ArraySegment<byte>(buffer, start, length);
+                start = delimiter + 1;
+                scanned = 0;
+                return true;
+            }
+            
+            scanned = available;
+            if (available > maxFrameLength)
+                throw new InvalidDataException($"No message delimiter within {maxFrameLength} bytes");
+            
+            EnsureCapacity(available + 1);
+        }
+        
+        frame = default;
+        return false;
+    }
+    
+    /// <summary>
+    /// Reads more bytes from the stream. Returns false at end of stream.
+    /// </summary>
+    private bool Fill()
+    {
+        // Move the partial frame to the front so the free space is contiguous
+        if (end == buffer.Length && start > 0)
+        {
+            Compact();
+        }
+        
+        int bytesRead = stream.Read(buffer, end, buffer.Length - end);
+        if (bytesRead <= 0)
+            return false;
+        
+        end += bytesRead;
+        return true;
+    }
+    
+    /// <summary>
+    /// Makes room for a partial frame that needs the given number of bytes in total
+    /// </summary>
+    private void EnsureCapacity(int required)
+    {
+        if (required <= buffer.Length - start)
+            return;
+        
+        if (required <= buffer.Length)
+        {
+            Compact();
+            return;
+        }
+        
+        byte[] larger = ArrayPool<byte>.Shared.Rent(required);
+        Buffer.BlockCopy(buffer, start, larger, 0, end - start);
+        ArrayPool<byte>.Shared.Return(buffer);
+        buffer = larger;
+        end -= start;
+        start = 0;
+    }
+    
+    private void Compact()
+    {
+        int remaining = end - start;
+        if (remaining > 0)
+        {
+            Buffer.BlockCopy(buffer, start, buffer, 0, remaining);
+        }
+        start = 0;
+        end = remaining;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+using System;
+using System.Buffers.Binary;
+using System.Text;
+
+/// <summary>
+/// How messages are delimited on the simulation server connection
+/// </summary>
+public enum MessageFraming
+{
+    LengthPrefixed,     // 4-byte little-endian payload length, then the payload
+    NewlineDelimited,   // Payload followed by '\n' (compatibility with line-based servers)
+    Unframed            // Bare payload, one message per socket write and read (servers predating framing; sockets only)
+}
+
+/// <summary>
+/// Encodes outgoing messages into frames for a given MessageFraming.
+/// Unframed messages carry no boundary, so callers must write each one on its own.
+/// </summary>
+public static class MessageFrame
+{
+    public const int LengthPrefixSize = 4;
+    public const byte Delimiter = (byte)'\n';
+    
+    private static readonly UTF8Encoding utf8 = new UTF8Encoding(false);
+    
+    /// <summary>
+    /// Upper bound of the encoded frame size for a message, for sizing buffers
+    /// </summary>
+    public static int GetMaxFrameLength(string message)
+    {
+        // The length prefix is the larger of the two framing overheads
+        return utf8.GetMaxByteCount(message.Length) + LengthPrefixSize;
+    }
+    
+    /// <summary>
+    /// Writes a message as one frame into buffer at offset. Returns the number of bytes written.
+    /// The buffer must hold at least GetMaxFrameLength(message) bytes past offset.
+    /// </summary>
+    public static int Write(string message, MessageFraming framing, byte[] buffer, int offset)
+    {
+        if (framing == MessageFraming.LengthPrefixed)
+        {
+            int payloadLength = utf8.GetBytes(message, 0, message.Length, buffer, offset + LengthPrefixSize);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(buffer, offset, LengthPrefixSize), payloadLength);
+            return LengthPrefixSize + payloadLength;
+        }
+        
+        int length = utf8.GetBytes(message, 0, message.Length, buffer, offset);
+        if (framing == MessageFraming.Unframed)
+            return length;
+        
+        buffer[offset + length] = Delimiter;
+        return length + 1;
+    }
+    
+    /// <summary>
+    /// Upper bound of the encoded frame size for a binary payload
+    /// </summary>
+    public static int GetMaxFrameLength(int payloadLength)
+    {
+        return payloadLength + LengthPrefixSize;
+    }
+    
+    /// <summary>
+    /// Writes a binary payload as one frame into buffer at offset. Returns the number of bytes written.
+    /// Binary payloads may contain the delimiter and are only safe with length-prefixed framing.
+    /// </summary>
+    public static int Write(byte[] payload, int payloadLength, MessageFraming framing, byte[] buffer, int offset)
+    {
+        if (framing == MessageFraming.LengthPrefixed)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(buffer, offset, LengthPrefixSize), payloadLength);
+            Buffer.BlockCopy(payload, 0, buffer, offset + LengthPrefixSize, payloadLength);
+            return LengthPrefixSize + payloadLength;
+        }
+        
+        Buffer.BlockCopy(payload, 0, buffer, offset, payloadLength);
+        if (framing == MessageFraming.Unframed)
+            return payloadLength;
+        
+        buffer[offset + payloadLength] = Delimiter;
+        return payloadLength + 1;
+    }
+}
\ No newline at end of file
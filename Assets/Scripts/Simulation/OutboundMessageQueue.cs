@@ -0,0 +1,233 @@
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+using System.Threading;
+
+/// <summary>
+/// What the client does when its outbound queue is full
+/// </summary>
+public enum SendOverflowPolicy
+{
+    DropOldest,          // Discard the oldest queued message
+    CoalesceByComponent, // A newer state of a component/zone replaces its queued one; when full, discard the oldest
+    BlockProducer        // Background producers only: they wait up to the block timeout for room. The main thread never waits and coalesces instead (logged once)
+}
+
+/// <summary>
+/// Queued outgoing message: JSON text, or a pooled binary payload returned to the pool once written or dropped.
+/// Messages with a coalesce key carry the complete state of one component or zone.
+/// </summary>
+public struct OutboundMessage
+{
+    public string text;
+    public byte[] payload;
+    public int length;
+    public string coalesceKey;
+    
+    // Emptied in the queue by coalescing; skipped by the send thread
+    public bool IsEmpty => text == null && payload == null;
+    
+    public int MaxFrameLength => text != null ? MessageFrame.GetMaxFrameLength(text) : MessageFrame.GetMaxFrameLength(length);
+    
+    public int Write(MessageFraming framing, byte[] buffer, int offset)
+    {
+        return text != null ? MessageFrame.Write(text, framing, buffer, offset) : MessageFrame.Write(payload, length, framing, buffer, offset);
+    }
+    
+    public void Release()
+    {
+        if (payload != null)
+        {
+            ArrayPool<byte>.Shared.Return(payload);
+            payload = null;
+        }
+    }
+}
+
+/// <summary>
+/// Bounded FIFO of outgoing data messages between any producer thread and the send thread.
+/// Slots are addressed by a running sequence number. A coalesced message is emptied in place and the
+/// newer state appended, so the server never sees an older state after a newer one (batches are not
+/// keyed and may carry the same component). Emptied slots are compacted away only when the queue is full.
+/// The lock is only held to move a message in or out, never while writing. The thread that creates the
+/// queue (the Unity main thread) never waits for room, whatever the policy.
+/// </summary>
+public class OutboundMessageQueue
+{
+    private readonly object gate = new object();
+    private readonly OutboundMessage[] slots;
+    private readonly Dictionary<string, long> queuedKeys = new Dictionary<string, long>(StringComparer.Ordinal);
+    private long head; // Sequence of the oldest queued message
+    private long tail; // Sequence of the next message
+    private int emptySlots;
+    private readonly int nonBlockingThreadId;
+    
+    private long droppedCount;
+    private long coalescedCount;
+    private long blockFallbackCount;
+    
+    public int Capacity => slots.Length;
+    public SendOverflowPolicy Policy { get; set; } = SendOverflowPolicy.CoalesceByComponent;
+    public int BlockTimeoutMilliseconds { get; set; } = 100;
+    
+    public int Count
+    {
+        get { lock (gate) { return (int)(tail - head) - emptySlots; } }
+    }
+    
+    public long DroppedCount => Interlocked.Read(ref droppedCount);
+    public long CoalescedCount => Interlocked.Read(ref coalescedCount);
+    
+    /// <summary>
+    /// Messages the main thread queued under BlockProducer, which coalesced instead of waiting for room
+    /// </summary>
+    public long BlockFallbackCount => Interlocked.Read(ref blockFallbackCount);
+    
+    public OutboundMessageQueue(int capacity)
+    {
+        slots = new OutboundMessage[Math.Max(capacity, 1)];
+        nonBlockingThreadId = Thread.CurrentThread.ManagedThreadId;
+    }
+    
+    /// <summary>
+    /// Queues a message, applying the overflow policy when the queue is full
+    /// </summary>
+    public void Enqueue(OutboundMessage message)
+    {
+        lock (gate)
+        {
+            // Waiting on the main thread would stall the frame, so there BlockProducer falls back to coalescing
+            bool mayBlock = Policy == SendOverflowPolicy.BlockProducer && Thread.CurrentThread.ManagedThreadId != nonBlockingThreadId;
+            if (Policy == SendOverflowPolicy.BlockProducer && !mayBlock && Interlocked.Increment(ref blockFallbackCount) == 1)
+            {
+                UnityEngine.Debug.LogWarning("BlockProducer only applies to background producers; messages sent from the main thread are coalesced instead");
+            }
+            bool coalesce = Policy != SendOverflowPolicy.DropOldest && !mayBlock && message.coalesceKey != null;
+            if (coalesce && queuedKeys.TryGetValue(message.coalesceKey, out long queued))
+            {
+                // The newer state supersedes the queued one
+                ref OutboundMessage slot = ref slots[queued % slots.Length];
+                slot.Release();
+                slot = default;
+                emptySlots++;
+                queuedKeys.Remove(message.coalesceKey);
+                Interlocked.Increment(ref coalescedCount);
+            }
+            
+            if (tail - head == slots.Length && emptySlots > 0)
+            {
+                Compact();
+            }
+            
+            if (tail - head == slots.Length && mayBlock)
+            {
+                int deadline = Environment.TickCount + BlockTimeoutMilliseconds;
+                int remaining = BlockTimeoutMilliseconds;
+                while (tail - head == slots.Length && remaining > 0)
+                {
+                    Monitor.Wait(gate, remaining);
+                    remaining = deadline - Environment.TickCount;
+                }
+            }
+            
+            if (tail - head == slots.Length)
+            {
+                OutboundMessage dropped = RemoveOldest();
+                dropped.Release();
+                Interlocked.Increment(ref droppedCount);
+            }
+            
+            slots[tail % slots.Length] = message;
+            if (coalesce)
+            {
+                queuedKeys[message.coalesceKey] = tail;
+            }
+            tail++;
+        }
+    }
+    
+    /// <summary>
+    /// Takes the oldest message (send thread)
+    /// </summary>
+    public bool TryDequeue(out OutboundMessage message)
+    {
+        lock (gate)
+        {
+            while (tail != head)
+            {
+                message = RemoveOldest();
+                if (Policy == SendOverflowPolicy.BlockProducer)
+                {
+                    Monitor.PulseAll(gate);
+                }
+                
+                if (!message.IsEmpty)
+                    return true;
+            }
+            
+            message = default;
+            return false;
+        }
+    }
+    
+    /// <summary>
+    /// Releases every queued message, e.g. when the connection they were meant for is gone
+    /// </summary>
+    public void Clear()
+    {
+        lock (gate)
+        {
+            while (tail != head)
+            {
+                RemoveOldest().Release();
+            }
+            queuedKeys.Clear();
+            Monitor.PulseAll(gate);
+        }
+    }
+    
+    private OutboundMessage RemoveOldest()
+    {
+        long index = head % slots.Length;
+        OutboundMessage message = slots[index];
+        slots[index] = default;
+        
+        if (message.IsEmpty)
+        {
+            emptySlots--;
+        }
+        else if (message.coalesceKey != null && queuedKeys.TryGetValue(message.coalesceKey, out long queued) && queued == head)
+        {
+            queuedKeys.Remove(message.coalesceKey);
+        }
+        head++;
+        return message;
+    }
+    
+    /// <summary>
+    /// Moves the queued messages together over the slots emptied by coalescing
+    /// </summary>
+    private void Compact()
+    {
+        long write = head;
+        for (long read = head; read < tail; read++)
+        {
+            OutboundMessage message = slots[read % slots.Length];
+            if (message.IsEmpty)
+                continue;
+            
+            if (write != read)
+            {
+                slots[write % slots.Length] = message;
+                slots[read % slots.Length] = default;
+                if (message.coalesceKey != null && queuedKeys.TryGetValue(message.coalesceKey, out long queued) && queued == read)
+                {
+                    queuedKeys[message.coalesceKey] = write;
+                }
+            }
+            write++;
+        }
+        tail = write;
+        emptySlots = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,394 @@
+using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Threading;
+
+/// <summary>
+/// Layout of the memory-mapped file shared with a simulation server on the same machine.
+/// The server creates and sizes the file; all fields are little-endian.
+///
+///   Header (64 bytes): magic, version, ring capacity, results capacity, server attached, client attached
+///   Ring to the client, then ring to the server: write position, read position (own cache lines), data
+///   Results region: sequence (odd while the server writes), count, then ComponentResult records
+///
+/// Rings carry the same frames as a socket (see MessageFraming). Positions only grow; the data index
+/// is position modulo capacity, which must be a power of two.
+/// </summary>
+public static class SharedMemoryLayout
+{
+    public const int Magic = 0x4D495342; // "BSIM"
+    public const int Version = 1;
+    
+    public const int MagicOffset = 0;
+    public const int VersionOffset = 4;
+    public const int RingCapacityOffset = 8;
+    public const int ResultsCapacityOffset = 12;
+    public const int ServerAttachedOffset = 16;
+    public const int ClientAttachedOffset = 20;
+    public const int HeaderSize = 64;
+    
+    public const int RingWriteOffset = 0;
+    public const int RingReadOffset = 64;
+    public const int RingDataOffset = 128;
+    
+    public const int ResultsSequenceOffset = 0;
+    public const int ResultsCountOffset = 8;
+    public const int ResultsDataOffset = 64;
+    
+    public static long GetRingSize(int capacity) => RingDataOffset + (long)capacity;
+    public static long GetToClientRingOffset() => HeaderSize;
+    public static long GetToServerRingOffset(int ringCapacity) => HeaderSize + GetRingSize(ringCapacity);
+    public static long GetResultsOffset(int ringCapacity) => HeaderSize + 2 * GetRingSize(ringCapacity);
+}
+
+/// <summary>
+/// Shared-memory connection to a co-located simulation server: two single-producer/single-consumer
+/// byte rings replace the socket, and bulk component results are read straight out of the mapped
+/// results region instead of being framed and decoded. Waiting readers and writers spin briefly, then
+/// sleep a millisecond at a time, so an idle link does not keep a core busy. The mapping is released
+/// only once no read or write is using it, whichever thread disposes the transport.
+/// </summary>
+public class SharedMemorySimulationTransport : ISimulationTransport, ISimulationResultChannel
+{
+    private readonly string path;
+    private MemoryMappedFile file;
+    private MemoryMappedViewAccessor accessor;
+    private volatile bool closed;
+    
+    // Read, Write and TryReadResults calls inside the mapping; the last one out releases it after Dispose
+    private int users;
+    private volatile bool disposeRequested;
+    private int released;
+    
+    private int ringCapacity;
+    private int resultsCapacity;
+    private long resultsOffset;
+    private long lastResultsSequence;
+    private ComponentResult[] resultsStaging = new ComponentResult[0];
+    
+    public SharedMemorySimulationTransport(string path)
+    {
+        this.path = path;
+    }
+    
+    public Stream Connect()
+    {
+        if (!File.Exists(path))
+            throw new FileNotFoundException("Simulation server shared memory not found", path);
+        
+        file = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.ReadWrite);
+        accessor = file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.ReadWrite);
+        
+        if (accessor.ReadInt32(SharedMemoryLayout.MagicOffset) != SharedMemoryLayout.Magic ||
+            accessor.ReadInt32(SharedMemoryLayout.VersionOffset) != SharedMemoryLayout.Version)
+            throw new InvalidDataException($"{path} is not a version {SharedMemoryLayout.Version} simulation shared memory file");
+        
+        ringCapacity = accessor.ReadInt32(SharedMemoryLayout.RingCapacityOffset);
+        resultsCapacity = accessor.ReadInt32(SharedMemoryLayout.ResultsCapacityOffset);
+        resultsOffset = SharedMemoryLayout.GetResultsOffset(ringCapacity);
+        
+        long requiredSize = resultsOffset + SharedMemoryLayout.ResultsDataOffset + (long)resultsCapacity * ComponentResult.Size;
+        if (ringCapacity <= 0 || (ringCapacity & (ringCapacity - 1)) != 0 || resultsCapacity < 0 || accessor.Capacity < requiredSize)
+            throw new InvalidDataException($"Invalid shared memory layout in {path}");
+        
+        if (accessor.ReadInt32(SharedMemoryLayout.ServerAttachedOffset) == 0)
+            throw new IOException("Simulation server is not attached to the shared memory");
+        
+        closed = false;
+        lastResultsSequence = accessor.ReadInt64(resultsOffset + SharedMemoryLayout.ResultsSequenceOffset);
+        accessor.Write(SharedMemoryLayout.ClientAttachedOffset, 1);
+        
+        return new RingStream(this,
+            SharedMemoryLayout.GetToClientRingOffset(),
+            SharedMemoryLayout.GetToServerRingOffset(ringCapacity));
+    }
+    
+    public void Close()
+    {
+        if (closed)
+            return;
+        
+        closed = true;
+        if (!Acquire())
+            return;
+        
+        try
+        {
+            accessor?.Write(SharedMemoryLayout.ClientAttachedOffset, 0);
+        }
+        finally
+        {
+            Release();
+        }
+    }
+    
+    public void Dispose()
+    {
+        Close();
+        disposeRequested = true;
+        if (Volatile.Read(ref users) == 0)
+        {
+            ReleaseMapping();
+        }
+    }
+    
+    /// <summary>
+    /// Enters a call that touches the mapping; false once the transport is being disposed
+    /// </summary>
+    private bool Acquire()
+    {
+        Interlocked.Increment(ref users);
+        if (disposeRequested)
+        {
+            Release();
+            return false;
+        }
+        return true;
+    }
+    
+    private void Release()
+    {
+        if (Interlocked.Decrement(ref users) == 0 && disposeRequested)
+        {
+            ReleaseMapping();
+        }
+    }
+    
+    private void ReleaseMapping()
+    {
+        if (Interlocked.Exchange(ref released, 1) != 0)
+            return;
+        
+        accessor?.Dispose();
+        accessor = null;
+        file?.Dispose();
+        file = null;
+    }
+    
+    /// <summary>
+    /// Waits for the other side of a ring: a short spin keeps latency low while traffic flows, after
+    /// which the thread sleeps instead of yielding in a loop
+    /// </summary>
+    private static void Wait(ref SpinWait spin)
+    {
+        if (spin.NextSpinWillYield)
+        {
+            Thread.Sleep(1);
+        }
+        else
+        {
+            spin.SpinOnce();
+        }
+    }
+    
+    /// <summary>
+    /// Copies the latest results published by the server, if it published since the last call.
+    /// Records are copied from the mapping in one block, with no framing or parsing. A publication that
+    /// changes while being copied is skipped and picked up on the next call.
+    /// </summary>
+    public bool TryReadResults(SimulationResultBuffer target)
+    {
+        if (closed || !Acquire())
+            return false;
+        
+        try
+        {
+            return ReadResults(target);
+        }
+        finally
+        {
+            Release();
+        }
+    }
+    
+    private bool ReadResults(SimulationResultBuffer target)
+    {
+        long sequence = accessor.ReadInt64(resultsOffset + SharedMemoryLayout.ResultsSequenceOffset);
+        if ((sequence & 1) != 0 || sequence == lastResultsSequence)
+            return false;
+        
+        Thread.MemoryBarrier();
+        int count = Math.Min(accessor.ReadInt32(resultsOffset + SharedMemoryLayout.ResultsCountOffset), resultsCapacity);
+        if (count > resultsStaging.Length)
+        {
+            resultsStaging = new ComponentResult[Math.Max(count, resultsStaging.Length * 2)];
+        }
+        if (count > 0)
+        {
+            accessor.ReadArray(resultsOffset + SharedMemoryLayout.ResultsDataOffset, resultsStaging, 0, count);
+        }
+        Thread.MemoryBarrier();
+        
+        if (accessor.ReadInt64(resultsOffset + SharedMemoryLayout.ResultsSequenceOffset) != sequence)
+            return false;
+        
+        lastResultsSequence = sequence;
+        target.Append(resultsStaging, null, count);
+        return count > 0;
+    }
+    
+    public override string ToString() => $"shm://{path}";
+    
+    /// <summary>
+    /// Reads from the ring to the client and writes to the ring to the server.
+    /// One reading thread and one writing thread, as in BuildingSimulationClient.
+    /// </summary>
+    private class RingStream : Stream
+    {
+        private readonly SharedMemorySimulationTransport owner;
+        private readonly MemoryMappedViewAccessor accessor;
+        private readonly long inbound;
+        private readonly long outbound;
+        private readonly int mask;
+        private long readPosition;
+        private long writePosition;
+        
+        public RingStream(SharedMemorySimulationTransport owner, long inbound, long outbound)
+        {
+            this.owner = owner;
+            accessor = owner.accessor;
+            this.inbound = inbound;
+            this.outbound = outbound;
+            mask = owner.ringCapacity - 1;
+            readPosition = accessor.ReadInt64(inbound + SharedMemoryLayout.RingReadOffset);
+            writePosition = accessor.ReadInt64(outbound + SharedMemoryLayout.RingWriteOffset);
+        }
+        
+        private bool ServerAttached => accessor.ReadInt32(SharedMemoryLayout.ServerAttachedOffset) != 0;
+        
+        public override bool CanRead => true;
+        public override bool CanWrite => true;
+        public override bool CanSeek => false;
+        public override long Length => throw new NotSupportedException();
+        public override long Position
+        {
+            get => throw new NotSupportedException();
+            set => throw new NotSupportedException();
+        }
+        
+        /// <summary>
+        /// Blocks until data is available; returns 0 once the transport is closed or the server detached
+        /// </summary>
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            if (!owner.Acquire())
+                return 0;
+            
+            try
+            {
+                return ReadRing(buffer, offset, count);
+            }
+            finally
+            {
+                owner.Release();
+            }
+        }
+        
+        /// <summary>
+        /// Blocks until everything fits into the ring; throws once the transport is closed or the server detached
+        /// </summary>
+        public override void Write(byte[] buffer, int offset, int count)
+        {
+            if (!owner.Acquire())
+                throw new IOException("Shared memory connection closed");
+            
+            try
+            {
+                WriteRing(buffer, offset, count);
+            }
+            finally
+            {
+                owner.Release();
+            }
+        }
+        
+        private int ReadRing(byte[] buffer, int offset, int count)
+        {
+            SpinWait spin = default;
+            while (!owner.closed)
+            {
+                long available = accessor.ReadInt64(inbound + SharedMemoryLayout.RingWriteOffset) - readPosition;
+                if (available > 0)
+                {
+                    Thread.MemoryBarrier();
+                    int length = (int)Math.Min(count, available);
+                    int start = (int)(readPosition & mask);
+                    int first = Math.Min(length, mask + 1 - start);
+                    long data = inbound + SharedMemoryLayout.RingDataOffset;
+                    
+                    accessor.ReadArray(data + start, buffer, offset, first);
+                    if (length > first)
+                    {
+                        accessor.ReadArray(data, buffer, offset + first, length - first);
+                    }
+                    
+                    // Hand the space back to the server only after copying out
+                    Thread.MemoryBarrier();
+                    readPosition += length;
+                    accessor.Write(inbound + SharedMemoryLayout.RingReadOffset, readPosition);
+                    return length;
+                }
+                
+                if (!ServerAttached)
+                    return 0;
+                
+                Wait(ref spin);
+            }
+            return 0;
+        }
+        
+        private void WriteRing(byte[] buffer, int offset, int count)
+        {
+            SpinWait spin = default;
+            while (count > 0)
+            {
+                if (owner.closed || !ServerAttached)
+                    throw new IOException("Shared memory connection closed");
+                
+                long free = mask + 1 - (writePosition - accessor.ReadInt64(outbound + SharedMemoryLayout.RingReadOffset));
+                if (free <= 0)
+                {
+                    Wait(ref spin);
+                    continue;
+                }
+                
+                Thread.MemoryBarrier();
+                int length = (int)Math.Min(count, free);
+                int start = (int)(writePosition & mask);
+                int first = Math.Min(length, mask + 1 - start);
+                long data = outbound + SharedMemoryLayout.RingDataOffset;
+                
+                accessor.WriteArray(data + start, buffer, offset, first);
+                if (length > first)
+                {
+                    accessor.WriteArray(data, buffer, offset + first, length - first);
+                }
+                
+                // Publish the bytes only after they are written
+                Thread.MemoryBarrier();
+                writePosition += length;
+                accessor.Write(outbound + SharedMemoryLayout.RingWriteOffset, writePosition);
+                
+                offset += length;
+                count -= length;
+                spin.Reset();
+            }
+        }
+        
+        public override void Flush()
+        {
+        }
+        
+        public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+        public override void SetLength(long value) => throw new NotSupportedException();
+        
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                owner.Close();
+            }
+            base.Dispose(disposing);
+        }
+    }
+}
\ No newline at end of file
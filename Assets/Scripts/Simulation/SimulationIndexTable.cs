@@ -0,0 +1,114 @@
+using System;
+using System.Collections.Generic;
+using Newtonsoft.Json;
+
+/// <summary>
+/// Interns component GlobalIds, zone ids and material names to dense indices for the binary protocol.
+/// New entries are announced to the server in one JSON INDEX message ahead of the first binary
+/// message that uses them. Indices are only valid for one connection. Main thread only.
+/// </summary>
+public class SimulationIndexTable
+{
+    public enum Kind
+    {
+        Component,
+        Zone,
+        Material
+    }
+    
+    private static readonly string[] kindNames = { "component", "zone", "material" };
+    
+    private readonly Dictionary<string, int>[] indices =
+    {
+        new Dictionary<string, int>(StringComparer.Ordinal),
+        new Dictionary<string, int>(StringComparer.Ordinal),
+        new Dictionary<string, int>(StringComparer.Ordinal)
+    };
+    
+    private readonly List<string>[] ids =
+    {
+        new List<string>(),
+        new List<string>(),
+        new List<string>()
+    };
+    
+    private readonly List<Dictionary<string, object>> pendingEntries = new List<Dictionary<string, object>>();
+    
+    public bool HasPendingEntries => pendingEntries.Count > 0;
+    
+    /// <summary>
+    /// Returns the index of an id, assigning the next free one on first use (-1 for empty ids)
+    /// </summary>
+    public int Intern(Kind kind, string id)
+    {
+        if (string.IsNullOrEmpty(id))
+            return -1;
+        
+        Dictionary<string, int> table = indices[(int)kind];
+        if (table.TryGetValue(id, out int index))
+            return index;
+        
+        index = table.Count;
+        table.Add(id, index);
+        ids[(int)kind].Add(id);
+        pendingEntries.Add(new Dictionary<string, object>
+        {
+            { "kind", kindNames[(int)kind] },
+            { "index", index },
+            { "id", id }
+        });
+        return index;
+    }
+    
+    /// <summary>
+    /// Looks up an already interned id without assigning one
+    /// </summary>
+    public bool TryGetIndex(Kind kind, string id, out int index)
+    {
+        index = -1;
+        return !string.IsNullOrEmpty(id) && indices[(int)kind].TryGetValue(id, out index);
+    }
+    
+    /// <summary>
+    /// Returns the id interned at an index, or null if the index was never assigned
+    /// </summary>
+    public string GetId(Kind kind, int index)
+    {
+        List<string> list = ids[(int)kind];
+        return index >= 0 && index < list.Count ? list[index] : null;
+    }
+    
+    /// <summary>
+    /// Builds the INDEX message for entries not yet announced, or returns null if there are none
+    /// </summary>
+    public string TakePendingMessage()
+    {
+        if (pendingEntries.Count == 0)
+            return null;
+        
+        Dictionary<string, object> message = new Dictionary<string, object>
+        {
+            { "type", "INDEX" },
+            { "entries", pendingEntries }
+        };
+        string json = JsonConvert.SerializeObject(message);
+        pendingEntries.Clear();
+        return json;
+    }
+    
+    /// <summary>
+    /// Forgets all indices (the server's table is per connection)
+    /// </summary>
+    public void Clear()
+    {
+        foreach (var table in indices)
+        {
+            table.Clear();
+        }
+        foreach (var list in ids)
+        {
+            list.Clear();
+        }
+        pendingEntries.Clear();
+    }
+}
\ No newline at end of file
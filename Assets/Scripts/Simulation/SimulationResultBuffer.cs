@@ -0,0 +1,126 @@
+using System;
+
+/// <summary>
+/// One component's simulation result. NaN fields were not part of the result and are left unchanged.
+/// </summary>
+public struct ComponentResult
+{
+    // Binary layout: component index, surface temperature, inner temperature, moisture content
+    public const int Size = 16;
+    
+    public int componentIndex;  // SimulationIndexTable component index, or -1 when the result carries a GlobalId
+    public float surfaceTemperature;
+    public float innerTemperature;
+    public float moistureContent;
+    
+    public static ComponentResult Read(ReadOnlySpan<byte> source)
+    {
+        return new ComponentResult
+        {
+            componentIndex = BinaryProtocol.ReadInt(source, 0),
+            surfaceTemperature = BinaryProtocol.ReadFloat(source, 4),
+            innerTemperature = BinaryProtocol.ReadFloat(source, 8),
+            moistureContent = BinaryProtocol.ReadFloat(source, 12)
+        };
+    }
+    
+    public void Write(Span<byte> destination)
+    {
+        BinaryProtocol.WriteInt(destination, 0, componentIndex);
+        BinaryProtocol.WriteFloat(destination, 4, surfaceTemperature);
+        BinaryProtocol.WriteFloat(destination, 8, innerTemperature);
+        BinaryProtocol.WriteFloat(destination, 12, moistureContent);
+    }
+}
+
+/// <summary>
+/// Double-buffered component results: the receive thread appends decoded results to the write side,
+/// and the main thread swaps the sides once per frame and applies everything received since the last swap.
+/// Both sides are preallocated and only grow, so steady-state traffic does not allocate.
+/// </summary>
+public class SimulationResultBuffer
+{
+    private readonly object gate = new object();
+    
+    private ComponentResult[] writeResults;
+    private string[] writeIds;      // GlobalIds of results decoded from JSON (null entries for indexed results)
+    private int writeCount;
+    
+    private ComponentResult[] readResults;
+    private string[] readIds;
+    
+    public SimulationResultBuffer(int initialCapacity = 65536)
+    {
+        writeResults = new ComponentResult[initialCapacity];
+        writeIds = new string[initialCapacity];
+        readResults = new ComponentResult[initialCapacity];
+        readIds = new string[initialCapacity];
+    }
+    
+    /// <summary>
+    /// Appends decoded results (receive thread). ids may be null when every result is indexed.
+    /// </summary>
+    public void Append(ComponentResult[] results, string[] ids, int count)
+    {
+        if (count <= 0)
+            return;
+        
+        lock (gate)
+        {
+            int required = writeCount + count;
+            if (required > writeResults.Length)
+            {
+                int capacity = Math.Max(required, writeResults.Length * 2);
+                Array.Resize(ref writeResults, capacity);
+                Array.Resize(ref writeIds, capacity);
+            }
+            
+            Array.Copy(results, 0, writeResults, writeCount, count);
+            if (ids != null)
+            {
+                Array.Copy(ids, 0, writeIds, writeCount, count);
+            }
+            else
+            {
+                Array.Clear(writeIds, writeCount, count);
+            }
+            writeCount = required;
+        }
+    }
+    
+    /// <summary>
+    /// Takes everything appended since the last call (main thread). The returned arrays stay valid until the next call.
+    /// </summary>
+    public int Swap(out ComponentResult[] results, out string[] ids)
+    {
+        int count;
+        lock (gate)
+        {
+            ComponentResult[] previousResults = readResults;
+            string[] previousIds = readIds;
+            
+            readResults = writeResults;
+            readIds = writeIds;
+            count = writeCount;
+            
+            writeResults = previousResults;
+            writeIds = previousIds;
+            writeCount = 0;
+        }
+        
+        results = readResults;
+        ids = readIds;
+        return count;
+    }
+    
+    /// <summary>
+    /// Discards pending results (e.g. on disconnect)
+    /// </summary>
+    public void Clear()
+    {
+        lock (gate)
+        {
+            writeCount = 0;
+        }
+    }
+}
\ No newline at end of file
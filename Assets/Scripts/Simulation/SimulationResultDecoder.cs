@@ -0,0 +1,167 @@
+using System;
+using System.IO;
+using Newtonsoft.Json;
+
+/// <summary>
+/// Decodes COMPONENT_RESULTS messages on the receive thread into ComponentResult structs and appends them
+/// to a SimulationResultBuffer. Binary results carry component indices; JSON results are the fallback and
+/// carry GlobalIds. One decoder per receive thread; its staging arrays are reused across messages.
+/// </summary>
+public class SimulationResultDecoder
+{
+    public const string ResultsMessageType = "COMPONENT_RESULTS";
+    
+    private ComponentResult[] results = new ComponentResult[1024];
+    private string[] ids = new string[1024];
+    
+    /// <summary>
+    /// Decodes a binary COMPONENT_RESULTS frame. Returns false for other binary message types.
+    /// </summary>
+    public bool TryDecode(ArraySegment<byte> frame, SimulationResultBuffer target)
+    {
+        ReadOnlySpan<byte> payload = new ReadOnlySpan<byte>(frame.Array, frame.Offset, frame.Count);
+        if (!BinaryProtocol.IsBinary(payload) || BinaryProtocol.GetMessageType(payload) != BinaryProtocol.MessageType.ComponentResults)
+            return false;
+        
+        if (payload.Length < BinaryProtocol.ComponentResultsHeaderSize)
+            throw new InvalidDataException("Truncated COMPONENT_RESULTS header");
+        
+        int count = BinaryProtocol.ReadInt(payload, BinaryProtocol.HeaderSize);
+        if (count < 0 || (long)count * ComponentResult.Size > payload.Length - BinaryProtocol.ComponentResultsHeaderSize)
+            throw new InvalidDataException($"Invalid COMPONENT_RESULTS count {count}");
+        
+        EnsureCapacity(count);
+        
+        int offset = BinaryProtocol.ComponentResultsHeaderSize;
+        for (int i = 0; i < count; i++)
+        {
+            results[i] = ComponentResult.Read(payload.Slice(offset, ComponentResult.Size));
+            offset += ComponentResult.Size;
+        }
+        
+        target.Append(results, null, count);
+        return true;
+    }
+    
+    /// <summary>
+    /// Decodes a JSON COMPONENT_RESULTS message:
+    /// {"type":"COMPONENT_RESULTS","results":[{"componentId":"...","surfaceTemperature":..,"innerTemperature":..,"moistureContent":..}]}
+    /// Returns false for other message types.
+    /// </summary>
+    public bool TryDecode(string message, SimulationResultBuffer target)
+    {
+        string type = null;
+        int count = 0;
+        
+        try
+        {
+            using (JsonTextReader reader = new JsonTextReader(new StringReader(message)))
+            {
+                reader.DateParseHandling = DateParseHandling.None;
+                
+                if (!reader.Read() || reader.TokenType != JsonToken.StartObject)
+                    return false;
+                
+                while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+                {
+                    string property = (string)reader.Value;
+                    if (property == "type")
+                    {
+                        type = reader.ReadAsString();
+                    }
+                    else if (property == "results")
+                    {
+                        count = ReadResults(reader);
+                    }
+                    else
+                    {
+                        reader.Read();
+                        reader.Skip();
+                    }
+                }
+            }
+        }
+        catch (JsonException)
+        {
+            // Malformed message; left to the main-thread handlers
+            return false;
+        }
+        
+        if (type != ResultsMessageType)
+            return false;
+        
+        target.Append(results, ids, count);
+        return true;
+    }
+    
+    private int ReadResults(JsonTextReader reader)
+    {
+        int count = 0;
+        if (!reader.Read() || reader.TokenType != JsonToken.StartArray)
+        {
+            reader.Skip();
+            return 0;
+        }
+        
+        while (reader.Read() && reader.TokenType == JsonToken.StartObject)
+        {
+            ComponentResult result = new ComponentResult
+            {
+                componentIndex = -1,
+                surfaceTemperature = float.NaN,
+                innerTemperature = float.NaN,
+                moistureContent = float.NaN
+            };
+            string id = null;
+            
+            while (reader.Read() && reader.TokenType == JsonToken.PropertyName)
+            {
+                switch ((string)reader.Value)
+                {
+                    case "componentId":
+                        id = reader.ReadAsString();
+                        break;
+                    case "componentIndex":
+                        result.componentIndex = reader.ReadAsInt32() ?? -1;
+                        break;
+                    case "surfaceTemperature":
+                        result.surfaceTemperature = ReadFloat(reader);
+                        break;
+                    case "innerTemperature":
+                        result.innerTemperature = ReadFloat(reader);
+                        break;
+                    case "moistureContent":
+                        result.moistureContent = ReadFloat(reader);
+                        break;
+                    default:
+                        reader.Read();
+                        reader.Skip();
+                        break;
+                }
+            }
+            
+            EnsureCapacity(count + 1);
+            results[count] = result;
+            ids[count] = result.componentIndex >= 0 ? null : id;
+            count++;
+        }
+        
+        return count;
+    }
+    
+    private static float ReadFloat(JsonTextReader reader)
+    {
+        double? value = reader.ReadAsDouble();
+        return value.HasValue ? (float)value.Value : float.NaN;
+    }
+    
+    private void EnsureCapacity(int count)
+    {
+        if (count <= results.Length)
+            return;
+        
+        int capacity = Math.Max(count, results.Length * 2);
+        Array.Resize(ref results, capacity);
+        Array.Resize(ref ids, capacity);
+    }
+}
\ No newline at end of file
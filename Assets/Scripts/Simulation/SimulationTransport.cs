@@ -0,0 +1,170 @@
+using System;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+
+/// <summary>
+/// How BuildingSimulationClient reaches the simulation server
+/// </summary>
+public enum SimulationTransportKind
+{
+    Tcp,          // serverIP:serverPort
+    UnixSocket,   // Unix domain socket at a file path; same machine only, no TCP/IP stack
+    SharedMemory  // Memory-mapped file created by the server; same machine only, no kernel copies
+}
+
+/// <summary>
+/// A byte stream to the simulation server. Framing, encoding and threading stay in BuildingSimulationClient;
+/// a transport only opens the stream and releases blocked reads when closed.
+/// </summary>
+public interface ISimulationTransport : IDisposable
+{
+    /// <summary>
+    /// Blocks until connected and returns the stream; throws if the server is unreachable
+    /// </summary>
+    Stream Connect();
+    
+    /// <summary>
+    /// Closes the stream, releasing a read blocked on it. Safe to call from any thread, more than once.
+    /// </summary>
+    void Close();
+}
+
+/// <summary>
+/// Implemented by transports that can deliver component results out of band, without framing or decoding
+/// </summary>
+public interface ISimulationResultChannel
+{
+    /// <summary>
+    /// Appends the results published since the last call to target. Returns false if there were none.
+    /// </summary>
+    bool TryReadResults(SimulationResultBuffer target);
+}
+
+/// <summary>
+/// TCP connection, with Nagle disabled since messages are already coalesced by the send thread
+/// </summary>
+public class TcpSimulationTransport : ISimulationTransport
+{
+    private readonly string host;
+    private readonly int port;
+    private TcpClient client;
+    
+    public TcpSimulationTransport(string host, int port)
+    {
+        this.host = host;
+        this.port = port;
+    }
+    
+    public Stream Connect()
+    {
+        client = new TcpClient { NoDelay = true };
+        client.Connect(host, port);
+        return client.GetStream();
+    }
+    
+    public void Close()
+    {
+        client?.Close();
+    }
+    
+    public void Dispose()
+    {
+        Close();
+        client = null;
+    }
+    
+    public override string ToString() => $"tcp://{host}:{port}";
+}
+
+/// <summary>
+/// Unix domain socket connection for a server on the same machine (Linux, macOS, Windows 10 1803+)
+/// </summary>
+public class UnixSocketSimulationTransport : ISimulationTransport
+{
+    private readonly string path;
+    private Socket socket;
+    
+    public UnixSocketSimulationTransport(string path)
+    {
+        this.path = path;
+    }
+    
+    public Stream Connect()
+    {
+        socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+        socket.Connect(new UnixDomainEndPoint(path));
+        return new NetworkStream(socket, true);
+    }
+    
+    public void Close()
+    {
+        socket?.Close();
+    }
+    
+    public void Dispose()
+    {
+        Close();
+        socket = null;
+    }
+    
+    public override string ToString() => $"unix://{path}";
+}
+
+/// <summary>
+/// sockaddr_un endpoint. Serialized by hand because the framework's UnixDomainSocketEndPoint
+/// is not available on every Unity scripting backend.
+/// </summary>
+public class UnixDomainEndPoint : EndPoint
+{
+    // sun_path is 108 bytes on Linux, 104 on macOS, including the terminator
+    private const int MaxPathBytes = 103;
+    
+    public string Path { get; }
+    
+    public UnixDomainEndPoint(string path)
+    {
+        if (string.IsNullOrEmpty(path) || Encoding.UTF8.GetByteCount(path) > MaxPathBytes)
+            throw new ArgumentException($"Invalid Unix domain socket path '{path}'", nameof(path));
+        
+        Path = path;
+    }
+    
+    public override AddressFamily AddressFamily => AddressFamily.Unix;
+    
+    public override SocketAddress Serialize()
+    {
+        // Family (2 bytes, written by SocketAddress), then the NUL-terminated path
+        byte[] pathBytes = Encoding.UTF8.GetBytes(Path);
+        SocketAddress address = new SocketAddress(AddressFamily.Unix, 2 + pathBytes.Length + 1);
+        for (int i = 0; i < pathBytes.Length; i++)
+        {
+            address[2 + i] = pathBytes[i];
+        }
+        address[2 + pathBytes.Length] = 0;
+        return address;
+    }
+    
+    public override EndPoint Create(SocketAddress socketAddress)
+    {
+        int length = 0;
+        while (2 + length < socketAddress.Size && socketAddress[2 + length] != 0)
+        {
+            length++;
+        }
+        
+        // Unnamed (unbound) peer
+        if (length == 0)
+            return this;
+        
+        byte[] pathBytes = new byte[length];
+        for (int i = 0; i < length; i++)
+        {
+            pathBytes[i] = socketAddress[2 + i];
+        }
+        return new UnixDomainEndPoint(Encoding.UTF8.GetString(pathBytes));
+    }
+    
+    public override string ToString() => Path;
+}
\ No newline at end of file
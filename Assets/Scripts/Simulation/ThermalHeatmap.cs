@@ -0,0 +1,279 @@
+using UnityEngine;
+using Unity.Collections;
+
+/// <summary>
+/// GPU heatmap of the whole building. The state store's values for the selected field are uploaded once
+/// per frame into a single GraphicsBuffer indexed by dense component index; every BuildingComponent draws
+/// with one shared heatmap material that looks its value up and maps it through a color ramp.
+/// Changing the field, range or ramp only changes shader globals, so streaming results and switching fields
+/// never touch the renderers. Works with every URP asset, including URP-Performant on standalone headsets.
+/// </summary>
+[DefaultExecutionOrder(100)] // After BuildingSimulationManager has applied this frame's results
+public class ThermalHeatmap : MonoBehaviour
+{
+    public enum HeatmapField
+    {
+        SurfaceTemperature,
+        InnerTemperature,
+        MoistureContent
+    }
+    
+    [Header("Heatmap")]
+    public bool showHeatmap = false;
+    public HeatmapField field = HeatmapField.SurfaceTemperature;
+    [Tooltip("Material using the Building/ThermalHeatmap shader; created from the shader if empty")]
+    public Material heatmapMaterial;
+    
+    [Header("Range")]
+    public float minTemperature = 0.0f;   // °C
+    public float maxTemperature = 30.0f;  // °C
+    public float minMoisture = 0.0f;
+    public float maxMoisture = 0.2f;
+    
+    [Header("Colors")]
+    public Gradient colorRamp = CreateDefaultRamp();
+    [Tooltip("Color of components without a state (not registered with the simulation manager)")]
+    public Color missingColor = new Color(0.5f, 0.5f, 0.5f);
+    [Range(0f, 1f), Tooltip("How much the main light shades the heatmap colors")]
+    public float shading = 0.35f;
+    
+    [Header("References")]
+    public BuildingSimulationManager simulationManager;
+    
+    private const int RampWidth = 256;
+    
+    private static readonly int ComponentValuesId = Shader.PropertyToID("_ComponentValues");
+    private static readonly int ComponentValueCountId = Shader.PropertyToID("_ComponentValueCount");
+    private static readonly int HeatmapRangeId = Shader.PropertyToID("_HeatmapRange");
+    private static readonly int HeatmapRampId = Shader.PropertyToID("_HeatmapRamp");
+    private static readonly int HeatmapMissingColorId = Shader.PropertyToID("_HeatmapMissingColor");
+    private static readonly int ShadingId = Shader.PropertyToID("_Shading");
+    
+    private GraphicsBuffer valueBuffer;
+    private Texture2D rampTexture;
+    private Material createdMaterial;
+    
+    // Components currently drawn with the heatmap material (store count when it was applied)
+    private bool heatmapApplied = false;
+    private ComponentStateStore appliedStore;
+    private int appliedCount = 0;
+    
+    public bool IsShowing => heatmapApplied;
+    
+    void Start()
+    {
+        if (simulationManager == null)
+        {
+            simulationManager = BuildingSimulationManager.Instance;
+        }
+        
+        if (heatmapMaterial == null)
+        {
+            Shader shader = Shader.Find("Building/ThermalHeatmap");
+            if (shader != null)
+            {
+                createdMaterial = new Material(shader) { name = "ThermalHeatmap (Runtime)" };
+                heatmapMaterial = createdMaterial;
+            }
+            else
+            {
+                Debug.LogWarning("ThermalHeatmap: Building/ThermalHeatmap shader not found; add it to Always Included Shaders or assign a material");
+            }
+        }
+        
+        RefreshRamp();
+    }
+    
+    void LateUpdate()
+    {
+        ComponentStateStore store = simulationManager != null ? simulationManager.State : null;
+        bool show = showHeatmap && heatmapMaterial != null && store != null && store.IsCreated;
+        
+        if (!show)
+        {
+            if (heatmapApplied)
+            {
+                ApplyToComponents(null);
+            }
+            return;
+        }
+        
+        // Renderers are only touched when the heatmap is switched on and for components registered since
+        if (!heatmapApplied || appliedStore != store || appliedCount != store.Count)
+        {
+            ApplyToComponents(store);
+        }
+        
+        UploadValues(store);
+        SetGlobals();
+    }
+    
+    void OnDisable()
+    {
+        if (heatmapApplied)
+        {
+            ApplyToComponents(null);
+        }
+    }
+    
+    void OnDestroy()
+    {
+        if (valueBuffer != null)
+        {
+            valueBuffer.Release();
+            valueBuffer = null;
+        }
+        if (rampTexture != null)
+        {
+            Destroy(rampTexture);
+        }
+        if (createdMaterial != null)
+        {
+            Destroy(createdMaterial);
+        }
+    }
+    
+    /// <summary>
+    /// Shows or hides the heatmap
+    /// </summary>
+    public void SetVisible(bool visible)
+    {
+        showHeatmap = visible;
+    }
+    
+    /// <summary>
+    /// Selects the displayed field; costs nothing beyond the next upload
+    /// </summary>
+    public void SetField(HeatmapField newField)
+    {
+        field = newField;
+    }
+    
+    /// <summary>
+    /// Rebuilds the ramp texture after colorRamp was changed
+    /// </summary>
+    public void RefreshRamp()
+    {
+        if (rampTexture == null)
+        {
+            rampTexture = new Texture2D(RampWidth, 1, TextureFormat.RGBA32, false, false)
+            {
+                name = "ThermalHeatmapRamp",
+                wrapMode = TextureWrapMode.Clamp,
+                filterMode = FilterMode.Bilinear
+            };
+        }
+        
+        Color32[] pixels = new Color32[RampWidth];
+        for (int i = 0; i < RampWidth; i++)
+        {
+            pixels[i] = colorRamp.Evaluate(i / (float)(RampWidth - 1));
+        }
+        rampTexture.SetPixels32(pixels);
+        rampTexture.Apply(false);
+        
+        Shader.SetGlobalTexture(HeatmapRampId, rampTexture);
+    }
+    
+    private void ApplyToComponents(ComponentStateStore store)
+    {
+        // Switching stores or hiding: restore everything drawn with the heatmap
+        if (appliedStore != null && appliedStore != store)
+        {
+            SetComponentsHeatmap(appliedStore, 0, null);
+            appliedCount = 0;
+        }
+        
+        if (store == null)
+        {
+            heatmapApplied = false;
+            appliedStore = null;
+            appliedCount = 0;
+            return;
+        }
+        
+        int start = heatmapApplied && appliedStore == store ? appliedCount : 0;
+        SetComponentsHeatmap(store, start, heatmapMaterial);
+        
+        heatmapApplied = true;
+        appliedStore = store;
+        appliedCount = store.Count;
+    }
+    
+    private void SetComponentsHeatmap(ComponentStateStore store, int start, Material material)
+    {
+        int count = store.IsCreated ? store.Count : 0;
+        for (int i = start; i < count; i++)
+        {
+            BuildingComponent component = store.GetComponentAt(i);
+            if (component != null)
+            {
+                component.SetHeatmapMaterial(material);
+            }
+        }
+    }
+    
+    private void UploadValues(ComponentStateStore store)
+    {
+        NativeArray<float> values;
+        switch (field)
+        {
+            case HeatmapField.InnerTemperature:
+                values = store.InnerTemperature;
+                break;
+            case HeatmapField.MoistureContent:
+                values = store.MoistureContent;
+                break;
+            default:
+                values = store.SurfaceTemperature;
+                break;
+        }
+        
+        // Sized to the store's capacity, so it is only recreated when the store grows
+        if (valueBuffer == null || valueBuffer.count != values.Length)
+        {
+            valueBuffer?.Release();
+            valueBuffer = new GraphicsBuffer(GraphicsBuffer.Target.Structured, values.Length, sizeof(float));
+            Shader.SetGlobalBuffer(ComponentValuesId, valueBuffer);
+        }
+        
+        int count = store.Count;
+        if (count > 0)
+        {
+            valueBuffer.SetData(values, 0, 0, count);
+        }
+        Shader.SetGlobalInt(ComponentValueCountId, count);
+    }
+    
+    private void SetGlobals()
+    {
+        float min = field == HeatmapField.MoistureContent ? minMoisture : minTemperature;
+        float max = field == HeatmapField.MoistureContent ? maxMoisture : maxTemperature;
+        float span = Mathf.Max(max - min, 1e-5f);
+        
+        Shader.SetGlobalVector(HeatmapRangeId, new Vector4(min, 1.0f / span, 0, 0));
+        Shader.SetGlobalColor(HeatmapMissingColorId, missingColor);
+        heatmapMaterial.SetFloat(ShadingId, shading);
+    }
+    
+    private static Gradient CreateDefaultRamp()
+    {
+        // Cold blue through green and yellow to hot red
+        Gradient gradient = new Gradient();
+        gradient.SetKeys(
+            new[]
+            {
+                new GradientColorKey(new Color(0.10f, 0.20f, 0.85f), 0.0f),
+                new GradientColorKey(new Color(0.10f, 0.75f, 0.90f), 0.25f),
+                new GradientColorKey(new Color(0.20f, 0.80f, 0.25f), 0.5f),
+                new GradientColorKey(new Color(0.95f, 0.85f, 0.15f), 0.75f),
+                new GradientColorKey(new Color(0.90f, 0.15f, 0.10f), 1.0f)
+            },
+            new[]
+            {
+                new GradientAlphaKey(1.0f, 0.0f),
+                new GradientAlphaKey(1.0f, 1.0f)
+            });
+        return gradient;
+    }
+}
\ No newline at end of file
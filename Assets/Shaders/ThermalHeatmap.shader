@@ -0,0 +1,148 @@
+// Heatmap of BuildingComponent state, driven by ThermalHeatmap.
+// Values come from one structured buffer indexed by the component's dense state index and are mapped
+// through a ramp texture. The index comes from the vertex stream TEXCOORD3 (index + 1, 0 = none): part of
+// CombinedMeshChunk meshes, and an additional vertex stream on a component's own renderer, so no renderer
+// needs per-draw properties and all stay in the SRP Batcher.
+// The lookup runs per vertex so the per-pixel cost stays a single texture sample, which keeps it cheap
+// on mobile GPUs (URP-Performant, standalone VR). Requires compute buffer support in the vertex stage:
+// Vulkan, Metal, DX11+ or OpenGL ES 3.1.
+Shader "Building/ThermalHeatmap"
+{
+    Properties
+    {
+        _Shading ("Lighting Amount", Range(0, 1)) = 0.35
+    }
+
+    SubShader
+    {
+        Tags { "RenderType" = "Opaque" "RenderPipeline" = "UniversalPipeline" "Queue" = "Geometry" }
+
+        Pass
+        {
+            Name "ThermalHeatmap"
+            Tags { "LightMode" = "UniversalForward" }
+
+            HLSLPROGRAM
+            #pragma target 4.5
+            #pragma exclude_renderers gles d3d11_9x
+            #pragma vertex Vert
+            #pragma fragment Frag
+            #pragma multi_compile_instancing
+
+            #include "Packages/com.unity.render-pipelines.universal/ShaderLibrary/Core.hlsl"
+            #include "Packages/com.unity.render-pipelines.universal/ShaderLibrary/Lighting.hlsl"
+
+            // Globals set by ThermalHeatmap
+            StructuredBuffer<float> _ComponentValues;
+            int _ComponentValueCount;
+            float4 _HeatmapRange; // x = minimum, y = 1 / (maximum - minimum)
+            float4 _HeatmapMissingColor;
+            TEXTURE2D(_HeatmapRamp);
+            SAMPLER(sampler_HeatmapRamp);
+
+            CBUFFER_START(UnityPerMaterial)
+            float _Shading;
+            CBUFFER_END
+
+            struct Attributes
+            {
+                float4 positionOS : POSITION;
+                float3 normalOS : NORMAL;
+                float componentId : TEXCOORD3;
+                UNITY_VERTEX_INPUT_INSTANCE_ID
+            };
+
+            struct Varyings
+            {
+                float4 positionCS : SV_POSITION;
+                float3 normalWS : TEXCOORD0;
+                nointerpolation float2 heat : TEXCOORD1; // x = ramp position, y = 1 if the component has a value
+                UNITY_VERTEX_OUTPUT_STEREO
+            };
+
+            Varyings Vert(Attributes input)
+            {
+                Varyings output = (Varyings)0;
+                UNITY_SETUP_INSTANCE_ID(input);
+                UNITY_INITIALIZE_VERTEX_OUTPUT_STEREO(output);
+
+                output.positionCS = TransformObjectToHClip(input.positionOS.xyz);
+                output.normalWS = TransformObjectToWorldNormal(input.normalOS);
+
+                int index = (int)(input.componentId + 0.5) - 1;
+                if (index >= 0 && index < _ComponentValueCount)
+                {
+                    float value = _ComponentValues[index];
+                    output.heat = float2(saturate((value - _HeatmapRange.x) * _HeatmapRange.y), 1.0);
+                }
+                return output;
+            }
+
+            half4 Frag(Varyings input) : SV_Target
+            {
+                UNITY_SETUP_STEREO_EYE_INDEX_POST_VERTEX(input);
+
+                half3 color = input.heat.y > 0.5
+                    ? SAMPLE_TEXTURE2D_LOD(_HeatmapRamp, sampler_HeatmapRamp, float2(input.heat.x, 0.5), 0).rgb
+                    : _HeatmapMissingColor.rgb;
+
+                // Light wrap from the main light only, so surfaces stay readable without hiding the ramp
+                half nDotL = saturate(dot(normalize(input.normalWS), GetMainLight().direction));
+                color *= lerp(1.0, 0.5 + 0.5 * nDotL, _Shading);
+                return half4(color, 1.0);
+            }
+            ENDHLSL
+        }
+
+        Pass
+        {
+            Name "DepthOnly"
+            Tags { "LightMode" = "DepthOnly" }
+
+            ZWrite On
+            ColorMask R
+
+            HLSLPROGRAM
+            #pragma target 2.0
+            #pragma vertex DepthVert
+            #pragma fragment DepthFrag
+            #pragma multi_compile_instancing
+
+            #include "Packages/com.unity.render-pipelines.universal/ShaderLibrary/Core.hlsl"
+
+            CBUFFER_START(UnityPerMaterial)
+            float _Shading;
+            CBUFFER_END
+
+            struct Attributes
+            {
+                float4 positionOS : POSITION;
+                UNITY_VERTEX_INPUT_INSTANCE_ID
+            };
+
+            struct Varyings
+            {
+                float4 positionCS : SV_POSITION;
+                UNITY_VERTEX_OUTPUT_STEREO
+            };
+
+            Varyings DepthVert(Attributes input)
+            {
+                Varyings output = (Varyings)0;
+                UNITY_SETUP_INSTANCE_ID(input);
+                UNITY_INITIALIZE_VERTEX_OUTPUT_STEREO(output);
+                output.positionCS = TransformObjectToHClip(input.positionOS.xyz);
+                return output;
+            }
+
+            half DepthFrag(Varyings input) : SV_Target
+            {
+                UNITY_SETUP_STEREO_EYE_INDEX_POST_VERTEX(input);
+                return input.positionCS.z;
+            }
+            ENDHLSL
+        }
+    }
+
+    FallBack "Hidden/Universal Render Pipeline/FallbackError"
+}
\ No newline at end of file